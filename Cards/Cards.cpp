@@ -1,6 +1,7 @@
 #include "Cards.h"
 #include "../Player/Player.h"
 #include "../Orders/Orders.h"
+#include "../Game_Engine/GameOutput.h"
 #include <algorithm>
 #include <stdexcept>
 
@@ -37,40 +38,40 @@ namespace WarzoneCard {
         }
 
         Order* order = nullptr;
-        std::cout << "Card::play() called for ";
+        const char* action = nullptr;
         
         switch (type) {
             case CardType::Bomb:
-                std::cout << "Bomb card - creating Bomb order";
+                action = "Bomb card - creating Bomb order";
                 order = new Bomb();
                 break;
             case CardType::Reinforcement:
-                std::cout << "Reinforcement card - creating Deploy order (reinforcement equivalent)";
+                action = "Reinforcement card - creating Deploy order (reinforcement equivalent)";
                 order = new Deploy();
                 break;
             case CardType::Blockade:
-                std::cout << "Blockade card - creating Blockade order";
+                action = "Blockade card - creating Blockade order";
                 order = new Blockade();
                 break;
             case CardType::Airlift:
-                std::cout << "Airlift card - creating Airlift order";
+                action = "Airlift card - creating Airlift order";
                 order = new Airlift();
                 break;
             case CardType::Diplomacy:
-                std::cout << "Diplomacy card - creating Negotiate order";
+                action = "Diplomacy card - creating Negotiate order";
                 order = new Negotiate();
                 break;
             case CardType::Unknown:
             default:
-                std::cout << "Unknown card - no action taken";
+                player->getOutput()->print("Card::play() called for Unknown card - no action taken");
                 return;
         }
         
-        if (order && player->getOrdersList()) {
+        bool added = order && player->getOrdersList();
+        if (added) {
             player->getOrdersList()->add(order);
-            std::cout << " - order added to player's order list";
         }
-        std::cout << std::endl;
+        player->getOutput()->print("Card::play() called for ", action, added ? " - order added to player's order list" : "");
     }
 
     std::ostream& operator<<(std::ostream& os, const Card& card) {
@@ -36,7 +36,7 @@ Command& Command::operator=(const Command& other) {
 
 void Command::saveEffect(const std::string& effectStr) {
     *effect = effectStr;
-    notifyObservers();
+    notifyObservers(*this);
 }
 
 std::string Command::stringToLog() const {
@@ -121,7 +121,7 @@ void CommandProcessor::saveCommand(Command* cmd) {
         commands->push_back(cmd);
         *lastCommandLog = "Saved command: " + cmd->getCommandString();
         propagateObserversTo(*cmd);
-        notifyObservers();
+        notifyObservers(*this);
     }
 }
 
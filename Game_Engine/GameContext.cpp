@@ -0,0 +1,149 @@
+#include "GameContext.h"
+
+#include <algorithm>
+
+#include "../Player/Player.h"
+
+namespace {
+    // Bit helpers over a vector of 64-bit words indexed by bit number
+    inline bool testBit(const std::vector<uint64_t>& bits, size_t bit) {
+        return (bits[bit >> 6] >> (bit & 63)) & 1u;
+    }
+    inline void setBit(std::vector<uint64_t>& bits, size_t bit) {
+        bits[bit >> 6] |= uint64_t(1) << (bit & 63);
+    }
+}
+
+GameContext::GameContext() : stride(0), neutralPlayer(nullptr), negotiationVersion(0) {}
+
+// Copy constructor
+GameContext::GameContext(const GameContext& other) : stride(0), neutralPlayer(nullptr), negotiationVersion(0) {
+    copyFrom(other);
+}
+
+// Assignment operator
+GameContext& GameContext::operator=(const GameContext& other) {
+    if (this != &other) {
+        copyFrom(other);
+    }
+    return *this;
+}
+
+GameContext::~GameContext() {
+    delete neutralPlayer;
+}
+
+// Players are shared, not owned; the neutral player stays with the context that made it
+void GameContext::copyFrom(const GameContext& other) {
+    players = other.players;
+    playerIndex = other.playerIndex;
+    stride = other.stride;
+    negotiations = other.negotiations;
+    cardGrants = other.cardGrants;
+    negotiationVersion++;
+}
+
+// Copies every row into the wider matrix; only registration pays for it
+void GameContext::grow(size_t newStride) {
+    std::vector<uint64_t> wider(newStride * newStride / 64, 0);
+    for (size_t row = 0; row < stride; row++) {
+        std::copy(negotiations.begin() + row * stride / 64, negotiations.begin() + (row + 1) * stride / 64,
+                  wider.begin() + row * newStride / 64);
+    }
+    negotiations.swap(wider);
+    cardGrants.resize(newStride / 64, 0);
+    stride = newStride;
+}
+
+int GameContext::addPlayer(Player* p) {
+    if (!p) return -1;
+    auto found = playerIndex.emplace(p, (int)players.size());
+    if (!found.second) return found.first->second;
+    players.push_back(p);
+    if (players.size() > stride) {
+        grow(std::max<size_t>(64, stride * 2));
+    }
+    return found.first->second;
+}
+
+int GameContext::findPlayerIndex(const Player* p) const {
+    auto found = playerIndex.find(p);
+    return found == playerIndex.end() ? -1 : found->second;
+}
+
+const std::vector<Player*>& GameContext::getPlayers() const { return players; }
+
+bool GameContext::hasNegotiation(const Player* a, const Player* b) const {
+    int ia = findPlayerIndex(a);
+    int ib = ia >= 0 ? findPlayerIndex(b) : -1;
+    return ib >= 0 && testBit(negotiations, (size_t)ia * stride + ib);
+}
+
+void GameContext::addNegotiation(Player* a, Player* b) {
+    int ia = addPlayer(a);
+    int ib = addPlayer(b);
+    if (ia < 0 || ib < 0) return;     // a null player
+    setBit(negotiations, (size_t)ia * stride + ib);
+    setBit(negotiations, (size_t)ib * stride + ia);
+    negotiationVersion++;
+}
+
+unsigned GameContext::getNegotiationVersion() const {
+    return negotiationVersion;
+}
+
+bool GameContext::wasCardGranted(const Player* p) const {
+    int index = findPlayerIndex(p);
+    return index >= 0 && testBit(cardGrants, index);
+}
+
+void GameContext::markCardGranted(Player* p) {
+    int index = addPlayer(p);
+    if (index >= 0) setBit(cardGrants, index);
+}
+
+Player* GameContext::getNeutralPlayer() {
+    if (!neutralPlayer) {
+        neutralPlayer = new Player("Neutral");
+    }
+    return neutralPlayer;
+}
+
+bool GameContext::hasNeutralPlayer() const { return neutralPlayer != nullptr; }
+
+// Keeps the players and the matrix size; only rows of registered players can have bits set
+void GameContext::resetTurn() {
+    size_t rowWords = stride / 64;
+    std::fill(negotiations.begin(), negotiations.begin() + players.size() * rowWords, 0);
+    std::fill(cardGrants.begin(), cardGrants.end(), 0);
+    negotiationVersion++;
+}
+
+void GameContext::reset() {
+    resetTurn();
+    players.clear();
+    playerIndex.clear();
+    if (neutralPlayer) {
+        neutralPlayer->getTerritories()->clear();
+    }
+}
+
+std::ostream& operator<<(std::ostream& os, const GameContext& context) {
+    os << "GameContext(players=" << context.players.size() << ", negotiations=";
+    int pairs = 0;
+    for (size_t i = 0; i < context.players.size(); i++) {
+        for (size_t j = i + 1; j < context.players.size(); j++) {
+            if (testBit(context.negotiations, i * context.stride + j)) {
+                os << (pairs++ > 0 ? " " : "") << context.players[i]->getName() << "/" << context.players[j]->getName();
+            }
+        }
+    }
+    if (pairs == 0) os << "none";
+    int grants = 0;
+    for (size_t i = 0; i < context.players.size(); i++) {
+        if (testBit(context.cardGrants, i)) grants++;
+    }
+    os << ", card grants=" << grants << ", neutral territories="
+       << (context.neutralPlayer ? context.neutralPlayer->getTerritories()->size() : 0) << ")";
+    return os;
+}
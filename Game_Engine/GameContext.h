@@ -0,0 +1,66 @@
+#pragma once
+#ifndef GAMECONTEXT_H
+#define GAMECONTEXT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+class Player;
+
+// State that orders share within one game: which players negotiated this turn, who
+// was already granted a card for a conquest this turn, and the neutral player that
+// blockaded territories go to. The engine owns one per game and passes it to every
+// order it executes, so several engines can play in one process at the same time.
+//
+// Players get a dense index when they are registered: the engine registers its players
+// at the start of a game, and a player an order names for the first time is registered
+// then. Negotiations are one flat player x player bit matrix, bit a * stride + b, and
+// card grants a bit vector over the same indices, so both are answered with a hash
+// lookup and one bit test. The stride doubles when a player does not fit, so there is
+// no player limit.
+class GameContext {
+public:
+    GameContext();
+    GameContext(const GameContext& other);  // Copy constructor
+    GameContext& operator=(const GameContext& other);  // Assignment operator
+    ~GameContext();
+
+    // Dense index of p, registering it if needed; -1 for nullptr
+    int addPlayer(Player* p);
+    int findPlayerIndex(const Player* p) const;     // -1 if not registered; no scan
+    const std::vector<Player*>& getPlayers() const;
+
+    bool hasNegotiation(const Player* a, const Player* b) const;
+    void addNegotiation(Player* a, Player* b);
+    // Bumped whenever the negotiations change, like a territory's version
+    unsigned getNegotiationVersion() const;
+
+    bool wasCardGranted(const Player* p) const;
+    void markCardGranted(Player* p);
+
+    // Created on first use and deleted with the context. Copies make their own.
+    Player* getNeutralPlayer();
+    bool hasNeutralPlayer() const;
+
+    void resetTurn();       // Forgets negotiations and card grants
+    void reset();           // Also forgets the players and the neutral player's territories
+
+    friend std::ostream& operator<<(std::ostream& os, const GameContext& context);
+
+private:
+    std::vector<Player*> players;
+    std::unordered_map<const Player*, int> playerIndex;
+    size_t stride;                          // bits per matrix row, a multiple of 64, at least players.size()
+    std::vector<uint64_t> negotiations;     // symmetric, stride x stride bits
+    std::vector<uint64_t> cardGrants;       // stride bits
+    Player* neutralPlayer;
+    unsigned negotiationVersion;
+
+    void copyFrom(const GameContext& other);
+    void grow(size_t newStride);
+};
+
+#endif
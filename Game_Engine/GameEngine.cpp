@@ -8,6 +8,9 @@
 #include "../Cards/Cards.h"
 #include "../Player/Player.h"
 #include "../Command_processing/CommandProcessing.h" 
+#include "GameContext.h"
+#include "GameOutput.h"
+#include "../ThreadPool/ThreadPool.h"
 
 GameEngine::GameEngine() {
     states = new std::string[8]{
@@ -26,6 +29,12 @@ GameEngine::GameEngine() {
     gameMap = nullptr;
     gameDeck = new WarzoneCard::Deck();
     players = new std::vector<Player*>();
+
+    context = new GameContext();
+    output = &GameOutput::console();
+    maxTurns = 10;
+    seeded = false;
+    seed = 0;
 }
 
 //copy constructor
@@ -33,6 +42,11 @@ GameEngine::GameEngine(const GameEngine& other) {
     states = new std::string[8];
     transitions = new std::string[11];
     currentState = new int(*(other.currentState));
+    context = new GameContext(*other.context);
+    output = other.output;
+    maxTurns = other.maxTurns;
+    seeded = other.seeded;
+    seed = other.seed;
 
     for (int i = 0; i < 8; i++) {
         states[i] = other.states[i];
@@ -53,6 +67,11 @@ GameEngine& GameEngine::operator=(const GameEngine& other) {
         states = new std::string[8];
         transitions = new std::string[11];
         currentState = new int(*(other.currentState));
+        *context = *other.context;
+        output = other.output;
+        maxTurns = other.maxTurns;
+        seeded = other.seeded;
+        seed = other.seed;
 
         for (int i = 0; i < 8; i++) {
             states[i] = other.states[i];
@@ -69,6 +88,7 @@ GameEngine::~GameEngine() {
     delete[] states;
     delete[] transitions;
     delete currentState;
+    delete context;
     delete gameDeck;
     gameDeck = nullptr;
 
@@ -76,6 +96,9 @@ GameEngine::~GameEngine() {
         delete p;
     }
     players->clear();
+    for (Player* p : eliminatedPlayers) {
+        delete p;
+    }
     delete players;
     players = nullptr;
 
@@ -117,8 +140,7 @@ bool GameEngine::validateCommand(const std::string& command) const {
 //execute command and transition to thestate
 bool GameEngine::executeCommand(const std::string& command) {
     if (!validateCommand(command)) {
-        std::cout << "Invalid command '" << command << "' for current state '"
-            << states[*currentState] << "'" << std::endl;
+        output->print("Invalid command '", command, "' for current state '", states[*currentState], "'");
         return false;
     }
 
@@ -130,16 +152,18 @@ bool GameEngine::executeCommand(const std::string& command) {
             ss >> cmd >> filename; 
             
             MapLoader loader; 
+            loader.setQuiet(true);  //errors go to the engine's sink instead
             Map* loadedMap = loader.loadMap(filename);
+            if (!loader.getLastError().empty()) output->print(loader.getLastError());
 
             if (loadedMap) {
                 if (gameMap != nullptr) delete gameMap; 
                 gameMap = loadedMap;
-                std::cout << "Map " << filename << " loaded successfully." << std::endl;
+                output->print("Map ", filename, " loaded successfully.");
                 transition(1);
                 return true;
             } else {
-                std::cout << "Error: Failed to load map " << filename << ". Staying in 'start' state." << std::endl;
+                output->print("Error: Failed to load map ", filename, ". Staying in 'start' state.");
                 return false;
             }
         }
@@ -147,11 +171,11 @@ bool GameEngine::executeCommand(const std::string& command) {
     else if (*currentState == 1) {
         if (command == "validatemap") {
             if (gameMap != nullptr && gameMap->validate()) { 
-                std::cout << "Map successfully validated." << std::endl;
+                output->print("Map successfully validated.");
                 transition(2);
                 return true;
             } else {
-                std::cout << "Map validation FAILED. Staying in 'map loaded' state." << std::endl;
+                output->print("Map validation FAILED. Staying in 'map loaded' state.");
                 return false;
             }
         }
@@ -169,13 +193,13 @@ bool GameEngine::executeCommand(const std::string& command) {
             ss >> cmd >> name;
 
             if (players->size() >= 6) {
-                std::cout << "Cannot add player. Maximum of 6 players reached." << std::endl;
+                output->print("Cannot add player. Maximum of 6 players reached.");
                 return false;
             }
 
             Player* newPlayer = new Player(name); 
             players->push_back(newPlayer);
-            std::cout << "Player " << name << " added. Total players: " << players->size() << std::endl;
+            output->print("Player ", name, " added. Total players: ", players->size());
             
             transition(3);
             return true;
@@ -183,11 +207,11 @@ bool GameEngine::executeCommand(const std::string& command) {
         
         if (command == "gamestart") {
             if (players->size() >= 2) {
-                std::cout << "Game started. Moving to 'players added' state to begin setup." << std::endl;
+                output->print("Game started. Moving to 'players added' state to begin setup.");
                 transition(3);
                 return true;
             } else {
-                std::cout << "Cannot start game. Need at least 2 players." << std::endl;
+                output->print("Cannot start game. Need at least 2 players.");
                 return false;
             }
         }
@@ -200,15 +224,15 @@ bool GameEngine::executeCommand(const std::string& command) {
             ss >> cmd >> name;
 
             if (players->size() >= 6) {
-                std::cout << "Cannot add player. Maximum of 6 players reached." << std::endl;
+                output->print("Cannot add player. Maximum of 6 players reached.");
                 return false;
             }
 
             Player* newPlayer = new Player(name); 
             players->push_back(newPlayer);
-            std::cout << "Player " << name << " added. Total players: " << players->size() << std::endl;
+            output->print("Player ", name, " added. Total players: ", players->size());
             
-            notifyObservers();
+            notifyObservers(*this);
             return true;
         }
         else if (command == "assigncountries") {
@@ -224,7 +248,7 @@ bool GameEngine::executeCommand(const std::string& command) {
     }
     else if (*currentState == 5) {
         if (command == "issueorder") {
-            notifyObservers();
+            notifyObservers(*this);
             return true;
         }
         else if (command == "endissueorders") {
@@ -234,7 +258,7 @@ bool GameEngine::executeCommand(const std::string& command) {
     }
     else if (*currentState == 6) {
         if (command == "execorder") {
-            notifyObservers();
+            notifyObservers(*this);
             return true;
         }
         else if (command == "endexecorders") {
@@ -252,7 +276,7 @@ bool GameEngine::executeCommand(const std::string& command) {
             return true;
         }
         else if (command == "end") {
-            std::cout << "Game ended" << std::endl;
+            output->print("Game ended");
             return true;
         }
     }
@@ -260,6 +284,19 @@ bool GameEngine::executeCommand(const std::string& command) {
     return false;
 }
 
+//fork an already loaded board instead of reading the file again
+bool GameEngine::loadMap(const Map& board) {
+    if (!validateCommand("loadmap")) {
+        output->print("Invalid command 'loadmap' for current state '", states[*currentState], "'");
+        return false;
+    }
+    if (gameMap != nullptr) delete gameMap;
+    gameMap = new Map(board);
+    output->print("Map loaded successfully.");
+    transition(1);
+    return true;
+}
+
 //get current state as string
 std::string GameEngine::getCurrentState() const {
     return states[*currentState];
@@ -275,7 +312,7 @@ void GameEngine::transition(int newStateIndex) {
         return;
     }
     *currentState = newStateIndex;
-    notifyObservers();
+    notifyObservers(*this);
 }
 
 // add observer to the observer list
@@ -290,7 +327,7 @@ void GameEngine::removeObserver(Observer* observer) {
 
 // notify observers of state changes
 void GameEngine::notify() {
-    notifyObservers();
+    notifyObservers(*this);
 }
 
 std::string GameEngine::stringToLog() const {
@@ -486,21 +523,48 @@ void GameEngine::startupPhase() {
 }
 
 void GameEngine::reinforcementPhase() {
-    std::cout << "\n=== REINFORCEMENT PHASE ===" << std::endl;
+    output->print("\n=== REINFORCEMENT PHASE ===");
+    
+    //count territories per owner in one sweep over the map's packed state
+    std::vector<int> ownedCounts;
+    std::vector<int> continentBonuses;
+    if (gameMap) {
+        const TerritoryState& state = gameMap->getState();
+        ownedCounts = state.countByOwner();
+        continentBonuses.assign(ownedCounts.size(), 0);
+        //continent holders are cached in the state, so this is one step per continent
+        const std::vector<Continent*>& continents = gameMap->getContinents();
+        for (size_t c = 0; c < continents.size(); c++) {
+            int holder = state.getContinentOwnerIndex(gameMap->getContinentIndex(continents[c]));
+            if (holder >= 0) continentBonuses[holder] += continents[c]->getBonus();
+        }
+    }
     
     for (Player* player : *players) {
         int territoriesOwned = player->getTerritories()->size();
-        int reinforcements = std::max(3, territoriesOwned / 3);
+        int bonus = 0;
+        if (gameMap) {
+            int ownerIndex = gameMap->getState().findPlayerIndex(player);
+            territoriesOwned = ownerIndex >= 0 ? ownedCounts[ownerIndex] : 0;
+            bonus = ownerIndex >= 0 ? continentBonuses[ownerIndex] : 0;
+        }
+        int reinforcements = std::max(3, territoriesOwned / 3) + bonus;
         
         player->addReinforcement(reinforcements);
         
-        std::cout << player->getName() << " receives " << reinforcements 
-                  << " reinforcements (owns " << territoriesOwned << " territories)" << std::endl;
+        if (bonus > 0) {
+            output->print(player->getName(), " receives ", reinforcements, " reinforcements (owns ",
+                          territoriesOwned, " territories, continent bonus ", bonus, ")");
+        } else {
+            output->print(player->getName(), " receives ", reinforcements, " reinforcements (owns ",
+                          territoriesOwned, " territories)");
+        }
+        output->record({GameEventType::Reinforcement, player, reinforcements, nullptr});
     }
 }
 
 void GameEngine::issueOrdersPhase() {
-    std::cout << "\n=== ISSUE ORDERS PHASE ===" << std::endl;
+    output->print("\n=== ISSUE ORDERS PHASE ===");
     
     //track which players are done issuing orders
     std::vector<bool> playersDone(players->size(), false);
@@ -510,7 +574,7 @@ void GameEngine::issueOrdersPhase() {
         roundCount++;
         bool anyPlayerIssued = false;
         
-        std::cout << "\nIssue Orders Round " << roundCount << ":" << std::endl;
+        output->print("\nIssue Orders Round ", roundCount, ":");
         
         for (size_t i = 0; i < players->size(); i++) {
             Player* player = (*players)[i];
@@ -546,66 +610,114 @@ void GameEngine::issueOrdersPhase() {
                 anyPlayerIssued = true;
             } else {
                 playersDone[i] = true;
-                std::cout << player->getName() << " is done issuing orders" << std::endl;
+                output->print(player->getName(), " is done issuing orders");
             }
         }
         
         //if all players are done, stop
         if (!anyPlayerIssued) {
-            std::cout << "\nAll players done issuing orders" << std::endl;
+            output->print("\nAll players done issuing orders");
             break;
         }
     }
 }
 
+// Orders only read the board while validating and no order runs until all are
+// checked, so the board itself is the snapshot and the orders can be split across
+// the pool. Small turns stay on this thread.
+void GameEngine::validateOrdersPhase() {
+    std::vector<Order*> queued;
+    for (Player* player : *players) {
+        for (Order* order : *player->getOrdersList()->getOrders()) {
+            if (order) queued.push_back(order);
+        }
+    }
+    
+    const size_t kParallelPrecheckThreshold = 512;
+    ThreadPool& pool = ThreadPool::shared();
+    size_t workers = queued.size() >= kParallelPrecheckThreshold ? pool.size() + 1 : 1;
+    auto precheckSlice = [&](size_t slice) {
+        for (size_t i = slice; i < queued.size(); i += workers) {
+            queued[i]->precheck(*context);
+        }
+    };
+    if (workers > 1) {
+        pool.parallelFor(workers, precheckSlice);
+    } else {
+        precheckSlice(0);
+    }
+}
+
 void GameEngine::executeOrdersPhase() {
-    std::cout << "\n=== EXECUTE ORDERS PHASE ===" << std::endl;
+    output->print("\n=== EXECUTE ORDERS PHASE ===");
+    
+    //each list puts its deploys first; taking an order only moves the list's cursor
+    for (Player* player : *players) {
+        player->getOrdersList()->beginExecution();
+    }
+    
+    //validate everything up front; execution only revalidates orders whose
+    //territories an earlier order changed
+    validateOrdersPhase();
     
     //execute all deploy orders first
-    std::cout << "\nExecuting Deploy orders:" << std::endl;
+    output->print("\nExecuting Deploy orders:");
     for (Player* player : *players) {
-        std::vector<Order*>* orders = player->getOrdersList()->getOrders();
-        for (size_t i = 0; i < orders->size(); ) {
-            Order* order = (*orders)[i];
-            if (dynamic_cast<Deploy*>(order)) {
-                std::cout << "Executing " << player->getName() << "'s deploy order" << std::endl;
-                order->execute();
-                player->getOrdersList()->remove(i);
-            } else {
-                i++;
-            }
+        OrdersList* list = player->getOrdersList();
+        while (Order* order = list->nextDeploy()) {
+            output->print("Executing ", player->getName(), "'s deploy order");
+            order->executeChecked(*context);
+            output->record({GameEventType::OrderExecuted, player, order->isExecuted() ? 1 : 0, "Deploy"});
         }
     }
     
     //execute other orders (round robin style)
-    std::cout << "\nExecuting other orders:" << std::endl;
+    output->print("\nExecuting other orders:");
     bool hasOrders = true;
     while (hasOrders) {
         hasOrders = false;
         for (Player* player : *players) {
-            std::vector<Order*>* orders = player->getOrdersList()->getOrders();
-            if (!orders->empty()) {
-                Order* order = (*orders)[0];
-                std::cout << "Executing " << player->getName() << "'s " 
-                          << *order << std::endl;
-                order->execute();
-                player->getOrdersList()->remove(0);
+            Order* order = player->getOrdersList()->next();
+            if (order) {
+                output->print("Executing ", player->getName(), "'s ", *order);
+                order->executeChecked(*context);
+                output->record({GameEventType::OrderExecuted, player, order->isExecuted() ? 1 : 0, orderKindName(order->getKind())});
                 hasOrders = true;
             }
         }
     }
+    
+    //executed orders are deleted together, one notification per list
+    for (Player* player : *players) {
+        player->getOrdersList()->endExecution();
+    }
 }
 
 void GameEngine::mainGameLoop() {
-    std::cout << "\n========== MAIN GAME LOOP STARTED ==========" << std::endl;
+    output->print("\n========== MAIN GAME LOOP STARTED ==========");
     
     if (!gameMap || players->size() < 2) {
-        std::cout << "Cannot start game: need valid map and at least 2 players" << std::endl;
+        output->print("Cannot start game: need valid map and at least 2 players");
         return;
     }
     
+    //negotiations, card grants and neutral territories left by an earlier game
+    context->reset();
+    
+    //players report to the engine's sink and get their index in the context
+    for (Player* player : *players) {
+        player->setOutput(output);
+        context->addPlayer(player);
+    }
+    
     //for testing, give each player territories and armies
     std::vector<Territory*> allTerritories = gameMap->getTerritories();
+    if (seeded) {
+        //a seeded game deals the turn order and the territories at random
+        std::mt19937 rng(seed);
+        std::shuffle(players->begin(), players->end(), rng);
+        std::shuffle(allTerritories.begin(), allTerritories.end(), rng);
+    }
     for (size_t i = 0; i < allTerritories.size(); i++) {
         Player* owner = (*players)[i % players->size()];
         allTerritories[i]->setOwner(owner);
@@ -614,11 +726,12 @@ void GameEngine::mainGameLoop() {
     }
     
     int turnCount = 0;
-    int maxTurns = 10;  //limit turns for testing (as i said above)
     
-    while (turnCount < maxTurns) {
+    while (turnCount < maxTurns) {  //limit turns for testing (as i said above)
         turnCount++;
-        std::cout << "\n\n########## TURN " << turnCount << " ##########" << std::endl;
+        output->print("\n\n########## TURN ", turnCount, " ##########");
+        output->record({GameEventType::TurnStarted, nullptr, turnCount, nullptr});
+        context->resetTurn();   //negotiations and card grants last one turn
         
         reinforcementPhase();
       
@@ -627,10 +740,12 @@ void GameEngine::mainGameLoop() {
         executeOrdersPhase();
         
         //remove players with no territories
-        std::cout << "\n=== Checking for eliminated players ===" << std::endl;
+        output->print("\n=== Checking for eliminated players ===");
         for (auto it = players->begin(); it != players->end(); ) {
             if ((*it)->getTerritories()->empty()) {
-                std::cout << (*it)->getName() << " has been eliminated!" << std::endl;
+                output->print((*it)->getName(), " has been eliminated!");
+                output->record({GameEventType::PlayerEliminated, *it, turnCount, nullptr});
+                eliminatedPlayers.push_back(*it);
                 it = players->erase(it);
             } else {
                 ++it;
@@ -639,22 +754,53 @@ void GameEngine::mainGameLoop() {
         
         //win condition
         if (players->size() == 1) {
-            std::cout << "\n\n********** GAME OVER **********" << std::endl;
-            std::cout << (*players)[0]->getName() << " WINS!" << std::endl;
-            std::cout << "********************************" << std::endl;
+            output->print("\n\n********** GAME OVER **********");
+            output->print((*players)[0]->getName(), " WINS!");
+            output->print("********************************");
+            output->record({GameEventType::GameOver, (*players)[0], turnCount, nullptr});
             return;
         }
         
         //check if one player owns all territories
-        for (Player* player : *players) {
-            if (player->getTerritories()->size() == allTerritories.size()) {
-                std::cout << "\n\n********** GAME OVER **********" << std::endl;
-                std::cout << player->getName() << " WINS (owns all territories)!" << std::endl;
-                std::cout << "********************************" << std::endl;
-                return;
-            }
+        Player* soleOwner = gameMap->getState().getSoleOwner();
+        if (soleOwner) {
+            output->print("\n\n********** GAME OVER **********");
+            output->print(soleOwner->getName(), " WINS (owns all territories)!");
+            output->print("********************************");
+            output->record({GameEventType::GameOver, soleOwner, turnCount, nullptr});
+            return;
         }
     }
     
-    std::cout << "\n\nGame ended after " << maxTurns << " turns (testing limit reached)" << std::endl;
-}
\ No newline at end of file
+    output->print("\n\nGame ended after ", maxTurns, " turns (testing limit reached)");
+    output->record({GameEventType::TurnLimitReached, nullptr, maxTurns, nullptr});
+}
+
+void GameEngine::setOutput(GameOutput* out) {
+    output = out ? out : &GameOutput::console();
+}
+
+GameOutput* GameEngine::getOutput() const {
+    return output;
+}
+
+void GameEngine::setMaxTurns(int turns) {
+    maxTurns = turns;
+}
+
+int GameEngine::getMaxTurns() const {
+    return maxTurns;
+}
+
+void GameEngine::setSeed(unsigned value) {
+    seeded = true;
+    seed = value;
+}
+
+bool GameEngine::hasSeed() const {
+    return seeded;
+}
+
+unsigned GameEngine::getSeed() const {
+    return seed;
+}
@@ -8,6 +8,8 @@
 
 #include "../Logging/LoggingObserver.h"
 
+class GameContext;
+class GameOutput;
 class Map;
 class Player;
 namespace WarzoneCard { class Deck; }
@@ -22,6 +24,13 @@ private:
     WarzoneCard::Deck* gameDeck;
     std::vector<Player*>* players; 
 
+    GameContext* context;   // what this game's orders share
+    GameOutput* output;     // not owned
+    int maxTurns;
+    bool seeded;
+    unsigned seed;          // with seeded, deals the turn order and the territories
+    std::vector<Player*> eliminatedPlayers;     // deleted with the engine; events may still point at them
+
 public:
     GameEngine();
     GameEngine(const GameEngine& other);
@@ -29,6 +38,8 @@ public:
 
     bool validateCommand(const std::string& command) const;
     bool executeCommand(const std::string& command);
+    // The loadmap command for a map that is already loaded; the engine plays on its own copy
+    bool loadMap(const Map& board);
     std::string getCurrentState() const;
     void printCurrentState() const;
     void transition(int newStateIndex);
@@ -45,8 +56,23 @@ public:
     void mainGameLoop();
     void reinforcementPhase();
     void issueOrdersPhase();
+    void validateOrdersPhase();     // prechecks every queued order; run by executeOrdersPhase
     void executeOrdersPhase();
+
+    // Where commands and the game loop report; the console by default, nullptr restores
+    // it. mainGameLoop hands the same sink to every player. With a sink that does not
+    // want text (NullOutput, StructuredOutput) a game does no console I/O.
+    void setOutput(GameOutput* out);
+    GameOutput* getOutput() const;
+    void setMaxTurns(int turns);
+    int getMaxTurns() const;
+    // Without a seed mainGameLoop keeps the join order and deals the territories in map
+    // order. With one it shuffles both, the same way every time for the same seed.
+    void setSeed(unsigned value);
+    bool hasSeed() const;
+    unsigned getSeed() const;
     
+    GameContext* getContext() { return context; }
     std::vector<Player*>* getPlayers() { return players; }
     Map* getMap() { return gameMap; }
     WarzoneCard::Deck* getDeck() { return gameDeck; }
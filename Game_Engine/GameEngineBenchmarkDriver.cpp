@@ -0,0 +1,79 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "GameEngine.h"
+#include "GameOutput.h"
+#include "../Orders/Orders.h"
+
+namespace {
+    // Swallows whatever is written to it, so the console sink can be timed without a terminal
+    class DiscardBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+
+    struct GameRun {
+        int games;
+        double seconds;
+    };
+
+    // Plays two-player games on the map until minSeconds have passed, each against a fresh
+    // Sink, and returns how many fit. Loading the map and adding players is not timed.
+    template <typename Sink>
+    GameRun timeGames(const std::string& mapFile, double minSeconds) {
+        DiscardBuffer discard;
+        std::streambuf* console = std::cout.rdbuf(&discard);
+        GameRun run{0, 0.0};
+        while (run.seconds < minSeconds || run.games < 3) {
+            Sink output;
+            GameEngine engine;
+            engine.setOutput(&output);
+            engine.executeCommand("loadmap " + mapFile);
+            engine.executeCommand("validatemap");
+            engine.executeCommand("addplayer Alice");
+            engine.executeCommand("addplayer Bob");
+
+            auto start = std::chrono::steady_clock::now();
+            engine.mainGameLoop();
+            run.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            run.games++;
+        }
+        std::cout.rdbuf(console);
+        return run;
+    }
+
+    void printRun(const std::string& sink, const GameRun& run, double baseline) {
+        double perSecond = run.games / run.seconds;
+        std::cout << "  " << std::left << std::setw(12) << sink << std::right
+                  << std::setw(6) << run.games << " games  "
+                  << std::fixed << std::setprecision(1) << std::setw(9) << perSecond << " games/s  "
+                  << std::setprecision(2) << std::setw(6) << perSecond / baseline << "x" << std::endl;
+    }
+}
+
+// Times whole games against each output sink. The console row writes to std::cout
+// through a buffer that discards the text, so it measures formatting and stream cost
+// but not the terminal itself.
+void testHeadlessGameBenchmark() {
+    std::cout << "\n=== Headless Game Benchmark ===" << std::endl;
+    const std::string maps[] = {"Map/Asia.map", "Map/Europe.map", "Map/canada.map"};
+    for (const std::string& mapFile : maps) {
+        std::cout << mapFile << std::endl;
+        GameRun consoleRun = timeGames<ConsoleOutput>(mapFile, 1.0);
+        double baseline = consoleRun.games / consoleRun.seconds;
+        printRun("console", consoleRun, baseline);
+        printRun("buffered", timeGames<BufferedOutput>(mapFile, 1.0), baseline);
+        printRun("structured", timeGames<StructuredOutput>(mapFile, 1.0), baseline);
+        printRun("null", timeGames<NullOutput>(mapFile, 1.0), baseline);
+    }
+}
+
+#ifndef MAIN_DRIVER_INCLUDED
+int main() {
+    testHeadlessGameBenchmark();
+    return 0;
+}
+#endif
@@ -1,12 +1,16 @@
 #include "GameEngine.h"
+#include "GameOutput.h"
+#include "Tournament.h"
 #include "../Map/Map.h"
 #include "../Player/Player.h"
 #include "../Command_processing/CommandProcessing.h"
+#include "../ThreadPool/ThreadPool.h"
 #include <iostream>
 #include <string>
 #include <random>
 #include <algorithm>
 #include <sstream>
+#include <stdexcept>
 
 void testGameStates() {
     std::cout << "=== Testing Game Engine States ===" << std::endl;
@@ -108,4 +112,125 @@ void testMainGameLoop() {
     engine.mainGameLoop();
     
     std::cout << "\n=== Main Game Loop Test Complete ===" << std::endl;
-}
\ No newline at end of file
+}
+namespace {
+    // Plays the Asia test game against the given sink and returns whatever reached std::cout
+    std::string playCapturedGame(GameOutput* output) {
+        std::ostringstream captured;
+        std::streambuf* console = std::cout.rdbuf(captured.rdbuf());
+        {
+            GameEngine engine;
+            engine.setOutput(output);
+            engine.executeCommand("loadmap Map/Asia.map");
+            engine.executeCommand("validatemap");
+            engine.executeCommand("addplayer Alice");
+            engine.executeCommand("addplayer Bob");
+            engine.mainGameLoop();
+        }
+        std::cout.rdbuf(console);
+        return captured.str();
+    }
+}
+
+// The same game printed to the console, buffered and recorded as events must agree,
+// and the buffered and structured runs must not write to the console at all
+void testHeadlessGame() {
+    std::cout << "\n=== Testing Headless Game ===" << std::endl;
+
+    std::string consoleText = playCapturedGame(nullptr);
+    BufferedOutput buffered;
+    std::string bufferedLeak = playCapturedGame(&buffered);
+    StructuredOutput structured;
+    std::string structuredLeak = playCapturedGame(&structured);
+
+    size_t executedLines = 0;
+    for (size_t at = buffered.getText().find("\nExecuting "); at != std::string::npos;
+         at = buffered.getText().find("\nExecuting ", at + 1)) {
+        executedLines++;
+    }
+    const std::vector<GameEvent>& events = structured.getEvents();
+    bool agree = consoleText == buffered.getText() && bufferedLeak.empty() && structuredLeak.empty() &&
+                 !events.empty() && executedLines == (size_t)structured.count(GameEventType::OrderExecuted) + 2 * structured.count(GameEventType::TurnStarted);
+
+    std::cout << "Console " << consoleText.size() << " bytes, buffered " << buffered.getText().size()
+              << " bytes, " << events.size() << " events ending in " << events.back() << ": "
+              << (agree ? "consistent" : "INCONSISTENT") << std::endl;
+}
+
+// A tournament must give the same results on one thread and on several, the games of
+// a row must differ, and a game must match a lone engine from the map file dealt with
+// the same seed
+void testTournament() {
+    std::cout << "\n=== Testing Tournament ===" << std::endl;
+
+    TournamentOptions options;
+    options.maps = {"Map/Asia.map", "Map/Europe.map"};
+    options.playerCounts = {2, 3};
+    options.games = 6;
+    options.maxTurns = 15;
+
+    ThreadPool single(1);
+    options.pool = &single;
+    Tournament serial(options);
+    ThreadPool wide(4);
+    options.pool = &wide;
+    Tournament parallel(options);
+    if (!serial.run() || !parallel.run()) {
+        std::cout << "Tournament failed: " << serial.getLastError() << parallel.getLastError() << std::endl;
+        return;
+    }
+
+    bool same = serial.getResults().size() == parallel.getResults().size();
+    for (size_t i = 0; same && i < serial.getResults().size(); i++) {
+        const TournamentResult& a = serial.getResults()[i];
+        const TournamentResult& b = parallel.getResults()[i];
+        same = a.wins == b.wins && a.draws == b.draws && a.totalTurns == b.totalTurns &&
+               a.ordersExecuted == b.ordersExecuted && a.gameOrders == b.gameOrders;
+    }
+
+    // Every row should hold at least two different games
+    bool differ = true;
+    for (const TournamentResult& result : parallel.getResults()) {
+        bool rowDiffers = false;
+        for (int orders : result.gameOrders) {
+            if (orders != result.gameOrders[0]) rowDiffers = true;
+        }
+        differ = differ && rowDiffers;
+    }
+
+    // First game of the first row: Asia with two players
+    StructuredOutput events;
+    {
+        GameEngine engine;
+        engine.setOutput(&events);
+        engine.setMaxTurns(options.maxTurns);
+        engine.setSeed(parallel.gameSeed(0, 0, 0));
+        engine.executeCommand("loadmap Map/Asia.map");
+        engine.executeCommand("validatemap");
+        engine.executeCommand("addplayer Player1");
+        engine.executeCommand("addplayer Player2");
+        engine.mainGameLoop();
+    }
+    long long ordersExecuted = 0;
+    for (const GameEvent& event : events.getEvents()) {
+        if (event.type == GameEventType::OrderExecuted) ordersExecuted += event.value;
+    }
+    const TournamentResult& first = parallel.getResults()[0];
+    bool matches = !first.gameOrders.empty() && first.gameOrders[0] == ordersExecuted;
+
+    // A game that throws must reach the caller, not terminate a worker
+    bool rethrown = false;
+    try {
+        wide.parallelFor(8, [](size_t i) {
+            if (i == 3) throw std::runtime_error("game 3 failed");
+        });
+    } catch (const std::runtime_error&) {
+        rethrown = true;
+    }
+
+    std::cout << parallel << std::endl;
+    std::cout << "Same results on 1 and 4 threads: " << (same ? "yes" : "NO")
+              << ", games differ: " << (differ ? "yes" : "NO")
+              << ", matches a lone game: " << (matches ? "yes" : "NO")
+              << ", exceptions reach the caller: " << (rethrown ? "yes" : "NO") << std::endl;
+}
@@ -0,0 +1,65 @@
+#include "GameOutput.h"
+
+#include <algorithm>
+
+#include "../Player/Player.h"
+
+void GameOutput::record(const GameEvent&) {}
+
+GameOutput& GameOutput::console() {
+    static ConsoleOutput output;
+    return output;
+}
+
+bool ConsoleOutput::wantsText() const { return true; }
+
+void ConsoleOutput::writeLine(const std::string& line) {
+    std::cout << line << std::endl;
+}
+
+bool NullOutput::wantsText() const { return false; }
+
+void NullOutput::writeLine(const std::string&) {}
+
+bool BufferedOutput::wantsText() const { return true; }
+
+const std::string& BufferedOutput::getText() const { return text; }
+
+void BufferedOutput::flush(std::ostream& os) {
+    os << text;
+    os.flush();
+    text.clear();
+}
+
+void BufferedOutput::writeLine(const std::string& line) {
+    text += line;
+    text += '\n';
+}
+
+bool StructuredOutput::wantsText() const { return false; }
+
+void StructuredOutput::record(const GameEvent& event) {
+    events.push_back(event);
+}
+
+const std::vector<GameEvent>& StructuredOutput::getEvents() const { return events; }
+
+int StructuredOutput::count(GameEventType type) const {
+    return (int)std::count_if(events.begin(), events.end(), [type](const GameEvent& e) { return e.type == type; });
+}
+
+void StructuredOutput::clear() {
+    events.clear();
+}
+
+void StructuredOutput::writeLine(const std::string&) {}
+
+std::ostream& operator<<(std::ostream& os, const GameEvent& event) {
+    static const char* names[] = {"TurnStarted", "Reinforcement", "OrderIssued", "OrderExecuted",
+                                  "PlayerEliminated", "GameOver", "TurnLimitReached"};
+    os << "GameEvent(" << names[(int)event.type];
+    if (event.player) os << ", " << event.player->getName();
+    if (event.detail && *event.detail) os << ", " << event.detail;
+    os << ", " << event.value << ")";
+    return os;
+}
@@ -0,0 +1,106 @@
+#pragma once
+#ifndef GAMEOUTPUT_H
+#define GAMEOUTPUT_H
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class Player;
+
+// What happened during a game, for sinks that keep results rather than text
+enum class GameEventType {
+    TurnStarted,        // value: turn number
+    Reinforcement,      // value: armies received
+    OrderIssued,        // detail: order type
+    OrderExecuted,      // detail: order type, value: 1 if it took effect
+    PlayerEliminated,
+    GameOver,           // player: winner, value: turns played
+    TurnLimitReached    // value: turns played
+};
+
+struct GameEvent {
+    GameEventType type;
+    const Player* player;
+    int value;
+    const char* detail;     // a string literal such as the order type, or nullptr; never built per event
+
+    friend std::ostream& operator<<(std::ostream& os, const GameEvent& event);
+};
+
+// Where the engine, players and cards send what they report during a game. Lines are
+// only formatted for sinks that want text, so a game run against a NullOutput or a
+// StructuredOutput does no console I/O and builds no strings.
+class GameOutput {
+public:
+    virtual ~GameOutput() = default;
+
+    // False when print() would throw the text away, so callers can skip building it
+    virtual bool wantsText() const = 0;
+    virtual void record(const GameEvent& event);     // ignored unless the sink keeps events
+
+    template <typename... Parts>
+    void print(const Parts&... parts) {
+        if (!wantsText()) return;
+        std::ostringstream line;
+        (line << ... << parts);
+        writeLine(line.str());
+    }
+
+    // Shared console sink; the default for engines and players
+    static GameOutput& console();
+
+protected:
+    virtual void writeLine(const std::string& line) = 0;
+};
+
+// Every line straight to std::cout, as the engine has always printed
+class ConsoleOutput : public GameOutput {
+public:
+    bool wantsText() const override;
+
+protected:
+    void writeLine(const std::string& line) override;
+};
+
+// Drops everything
+class NullOutput : public GameOutput {
+public:
+    bool wantsText() const override;
+
+protected:
+    void writeLine(const std::string& line) override;
+};
+
+// Collects the text in memory to be written out in one go
+class BufferedOutput : public GameOutput {
+public:
+    bool wantsText() const override;
+    const std::string& getText() const;
+    void flush(std::ostream& os);           // writes and clears the buffer
+
+protected:
+    void writeLine(const std::string& line) override;
+
+private:
+    std::string text;
+};
+
+// Keeps the game events and no text
+class StructuredOutput : public GameOutput {
+public:
+    bool wantsText() const override;
+    void record(const GameEvent& event) override;
+    const std::vector<GameEvent>& getEvents() const;
+    int count(GameEventType type) const;
+    void clear();
+
+protected:
+    void writeLine(const std::string& line) override;
+
+private:
+    std::vector<GameEvent> events;
+};
+
+#endif
@@ -0,0 +1,217 @@
+#include "Tournament.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <sstream>
+
+#include "GameEngine.h"
+#include "GameOutput.h"
+#include "../Map/Map.h"
+#include "../ThreadPool/ThreadPool.h"
+
+namespace {
+    // Keeps how the game ended and how many orders took effect, and nothing else
+    class OutcomeOutput : public GameOutput {
+    public:
+        OutcomeOutput() : winner(nullptr), turns(0), ordersExecuted(0) {}
+
+        bool wantsText() const override { return false; }
+
+        void record(const GameEvent& event) override {
+            if (event.type == GameEventType::OrderExecuted) {
+                ordersExecuted += event.value;
+            } else if (event.type == GameEventType::GameOver) {
+                winner = event.player;
+                turns = event.value;
+            } else if (event.type == GameEventType::TurnLimitReached) {
+                turns = event.value;
+            }
+        }
+
+        const Player* winner;
+        int turns;
+        int ordersExecuted;
+
+    protected:
+        void writeLine(const std::string&) override {}
+    };
+
+    struct GameRecord {
+        int winner;         // seat, -1 for a draw
+        int turns;
+        int ordersExecuted;
+        double seconds;
+    };
+
+    GameRecord playGame(const Map& board, int playerCount, int maxTurns, unsigned seed) {
+        auto start = std::chrono::steady_clock::now();
+        OutcomeOutput outcome;
+        GameRecord record{-1, 0, 0, 0.0};
+        {
+            GameEngine engine;
+            engine.setOutput(&outcome);
+            engine.setMaxTurns(maxTurns);
+            engine.setSeed(seed);
+            engine.loadMap(board);
+            engine.executeCommand("validatemap");
+            for (int seat = 0; seat < playerCount; seat++) {
+                engine.executeCommand("addplayer Player" + std::to_string(seat + 1));
+            }
+            // Eliminated players leave the engine's list and the seed deals the turn
+            // order, so remember the seats in join order first
+            std::vector<Player*> seats = *engine.getPlayers();
+            engine.mainGameLoop();
+
+            for (int seat = 0; seat < playerCount; seat++) {
+                if (seats[seat] == outcome.winner) record.winner = seat;
+            }
+            record.turns = outcome.turns;
+            record.ordersExecuted = outcome.ordersExecuted;
+        }
+        record.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return record;
+    }
+}
+
+double TournamentResult::winRate(int seat) const {
+    return games > 0 ? 100.0 * wins[seat] / games : 0.0;
+}
+
+double TournamentResult::averageTurns() const {
+    return games > 0 ? (double)totalTurns / games : 0.0;
+}
+
+double TournamentResult::averageOrders() const {
+    return games > 0 ? (double)ordersExecuted / games : 0.0;
+}
+
+std::ostream& operator<<(std::ostream& os, const TournamentResult& result) {
+    std::ostringstream rates;
+    rates << std::fixed << std::setprecision(1);
+    for (int seat = 0; seat < result.players; seat++) {
+        rates << (seat > 0 ? " " : "") << result.winRate(seat);
+    }
+    os << std::left << std::setw(24) << result.map << std::right << std::setw(8) << result.players
+       << std::setw(7) << result.games << "  " << std::left << std::setw(32) << rates.str() << std::right
+       << std::setw(6) << result.draws << std::fixed << std::setprecision(1) << std::setw(11)
+       << result.averageTurns() << std::setw(6) << result.minTurns << std::setw(6) << result.maxTurns
+       << std::setw(13) << result.averageOrders();
+    return os;
+}
+
+Tournament::Tournament(const TournamentOptions& options) : options(options), wallSeconds(0.0) {}
+
+unsigned Tournament::gameSeed(size_t map, size_t count, int game) const {
+    size_t setup = map * options.playerCounts.size() + count;
+    return options.seed + (unsigned)(setup * (size_t)std::max(0, options.games) + (size_t)game);
+}
+
+bool Tournament::run() {
+    results.clear();
+    lastError.clear();
+    wallSeconds = 0.0;
+    for (int count : options.playerCounts) {
+        if (count < 2 || count > 6) {
+            lastError = "Player count " + std::to_string(count) + " is outside 2 to 6";
+            return false;
+        }
+    }
+
+    // Each map is read once; the games fork it
+    std::vector<Map*> boards;
+    for (const std::string& file : options.maps) {
+        MapLoader loader;
+        loader.setQuiet(true);
+        Map* board = loader.loadMap(file);
+        if (!board || !board->validate()) {
+            lastError = "Map " + file + " is invalid" + (loader.getLastError().empty() ? "" : ": " + loader.getLastError());
+            delete board;
+            for (Map* loaded : boards) delete loaded;
+            return false;
+        }
+        boards.push_back(board);
+    }
+
+    size_t setups = boards.size() * options.playerCounts.size();
+    size_t games = setups * (size_t)std::max(0, options.games);
+    std::vector<GameRecord> records(games);
+    ThreadPool& pool = options.pool ? *options.pool : ThreadPool::shared();
+    auto start = std::chrono::steady_clock::now();
+    try {
+        pool.parallelFor(games, [&](size_t i) {
+            size_t setup = i / options.games;
+            size_t map = setup / options.playerCounts.size();
+            size_t count = setup % options.playerCounts.size();
+            records[i] = playGame(*boards[map], options.playerCounts[count], options.maxTurns,
+                                  gameSeed(map, count, (int)(i % options.games)));
+        });
+    } catch (const std::exception& e) {
+        lastError = std::string("A game failed: ") + e.what();
+        for (Map* board : boards) delete board;
+        return false;
+    }
+    wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (size_t setup = 0; setup < setups; setup++) {
+        TournamentResult result;
+        result.map = options.maps[setup / options.playerCounts.size()];
+        result.players = options.playerCounts[setup % options.playerCounts.size()];
+        result.wins.assign(result.players, 0);
+        for (int g = 0; g < options.games; g++) {
+            const GameRecord& record = records[setup * options.games + g];
+            if (record.winner >= 0) result.wins[record.winner]++;
+            else result.draws++;
+            result.totalTurns += record.turns;
+            result.minTurns = g == 0 ? record.turns : std::min(result.minTurns, record.turns);
+            result.maxTurns = std::max(result.maxTurns, record.turns);
+            result.ordersExecuted += record.ordersExecuted;
+            result.gameOrders.push_back(record.ordersExecuted);
+            result.seconds += record.seconds;
+            result.games++;
+        }
+        results.push_back(result);
+    }
+
+    for (Map* board : boards) delete board;
+    return true;
+}
+
+const TournamentOptions& Tournament::getOptions() const {
+    return options;
+}
+
+const std::vector<TournamentResult>& Tournament::getResults() const {
+    return results;
+}
+
+const std::string& Tournament::getLastError() const {
+    return lastError;
+}
+
+int Tournament::getGamesPlayed() const {
+    int played = 0;
+    for (const TournamentResult& result : results) played += result.games;
+    return played;
+}
+
+double Tournament::getWallSeconds() const {
+    return wallSeconds;
+}
+
+std::ostream& operator<<(std::ostream& os, const Tournament& tournament) {
+    os << std::left << std::setw(24) << "map" << std::right << std::setw(8) << "players" << std::setw(7)
+       << "games" << "  " << std::left << std::setw(32) << "win % by seat" << std::right << std::setw(6)
+       << "draws" << std::setw(11) << "avg turns" << std::setw(6) << "min" << std::setw(6) << "max"
+       << std::setw(13) << "orders/game" << "\n";
+    for (const TournamentResult& result : tournament.results) {
+        os << result << "\n";
+    }
+    int played = tournament.getGamesPlayed();
+    os << played << " games in " << std::fixed << std::setprecision(2) << tournament.wallSeconds << " s";
+    if (tournament.wallSeconds > 0.0) {
+        os << " (" << std::setprecision(1) << played / tournament.wallSeconds << " games/s)";
+    }
+    return os;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+// What a tournament plays: every map with every player count, games times each
+struct TournamentOptions {
+    std::vector<std::string> maps;
+    std::vector<int> playerCounts = {2};    // 2 to 6
+    int games = 10;                         // per map and player count
+    int maxTurns = 100;                     // a game still running after this many turns is a draw
+    unsigned seed = 1;                      // game i of the tournament is dealt with seed + i
+    ThreadPool* pool = nullptr;             // nullptr uses ThreadPool::shared()
+};
+
+// Totals for one map and player count. Seat 0 is Player1, the first to join; each game
+// deals the turn order at random, so every seat moves first in some games.
+struct TournamentResult {
+    std::string map;
+    int players = 0;
+    int games = 0;
+    std::vector<int> wins;      // by seat
+    int draws = 0;
+    long long totalTurns = 0;
+    int minTurns = 0;
+    int maxTurns = 0;
+    long long ordersExecuted = 0;   // orders that took effect
+    std::vector<int> gameOrders;    // orders that took effect in each game, in game order
+    double seconds = 0.0;       // summed over the games, not wall clock
+
+    double winRate(int seat) const;
+    double averageTurns() const;
+    double averageOrders() const;
+
+    friend std::ostream& operator<<(std::ostream& os, const TournamentResult& result);
+};
+
+// Plays many complete games at once. Every game gets its own engine, with its own
+// GameContext, its own copy of the board and a sink that keeps only the outcome, so
+// games share nothing while they run. Idle threads take the next game as soon as they
+// finish one, so long and short games balance out. Each game is dealt from its own
+// seed, so the games differ, but the results do not depend on the number of threads
+// and the same options always give the same results.
+class Tournament {
+public:
+    explicit Tournament(const TournamentOptions& options);
+
+    // The seed game g of map m with player count c is dealt with, counting in option order
+    unsigned gameSeed(size_t map, size_t count, int game) const;
+
+    // Loads every map once, then plays all the games. Returns false, with nothing
+    // played, when a map cannot be loaded or is invalid or a player count is out of range.
+    bool run();
+
+    const TournamentOptions& getOptions() const;
+    const std::vector<TournamentResult>& getResults() const;    // one per map and player count, in option order
+    const std::string& getLastError() const;
+    int getGamesPlayed() const;
+    double getWallSeconds() const;
+
+    // Results as a table, one row per map and player count
+    friend std::ostream& operator<<(std::ostream& os, const Tournament& tournament);
+
+private:
+    TournamentOptions options;
+    std::vector<TournamentResult> results;
+    std::string lastError;
+    double wallSeconds;
+};
+
+#endif
@@ -0,0 +1,84 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Tournament.h"
+#include "../ThreadPool/ThreadPool.h"
+
+namespace {
+    void printTournamentUsage() {
+        std::cout << "Usage: Tournament <map>... [--players 2,3,4] [--games N] [--turns N] [--seed N] [--threads N]" << std::endl;
+    }
+
+    bool parseCounts(const std::string& value, std::vector<int>& counts) {
+        counts.clear();
+        std::stringstream ss(value);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            try {
+                counts.push_back(std::stoi(item));
+            } catch (const std::exception&) {
+                return false;
+            }
+        }
+        return !counts.empty();
+    }
+}
+
+// Plays every map with every player count the given number of times and prints the
+// win rates and turn counts. Returns 1 when the arguments or a map are invalid.
+int runTournament(int argc, char* argv[]) {
+    TournamentOptions options;
+    size_t threads = 0;
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--players" && hasValue) {
+                if (!parseCounts(argv[++i], options.playerCounts)) {
+                    printTournamentUsage();
+                    return 1;
+                }
+            } else if (arg == "--games" && hasValue) {
+                options.games = std::stoi(argv[++i]);
+            } else if (arg == "--turns" && hasValue) {
+                options.maxTurns = std::stoi(argv[++i]);
+            } else if (arg == "--seed" && hasValue) {
+                options.seed = (unsigned)std::stoul(argv[++i]);
+            } else if (arg == "--threads" && hasValue) {
+                threads = (size_t)std::stoul(argv[++i]);
+            } else if (arg.rfind("--", 0) == 0) {
+                printTournamentUsage();
+                return 1;
+            } else {
+                options.maps.push_back(arg);
+            }
+        }
+    } catch (const std::exception&) {
+        printTournamentUsage();
+        return 1;
+    }
+    if (options.maps.empty()) {
+        printTournamentUsage();
+        return 1;
+    }
+
+    // The shared pool unless a thread count was asked for
+    ThreadPool* pool = threads > 0 ? new ThreadPool(threads) : nullptr;
+    options.pool = pool;
+    Tournament tournament(options);
+    bool ok = tournament.run();
+    if (ok) {
+        std::cout << tournament << " with a pool of " << (pool ? pool->size() : ThreadPool::shared().size()) << " threads" << std::endl;
+    } else {
+        std::cout << tournament.getLastError() << std::endl;
+    }
+    delete pool;
+    return ok ? 0 : 1;
+}
+
+#ifndef MAIN_DRIVER_INCLUDED
+int main(int argc, char* argv[]) {
+    return runTournament(argc, argv);
+}
+#endif
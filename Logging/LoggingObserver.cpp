@@ -30,13 +30,6 @@ void Subject::attach(Observer* observer) {
 void Subject::detach(Observer* observer) {
     observers.erase(std::remove(observers.begin(), observers.end(), observer), observers.end());
 }
-//notify all observers of the subject
-void Subject::notifyObservers() const {
-    const ILoggable* loggable = dynamic_cast<const ILoggable*>(this);
-    if (loggable) {
-        notifyObservers(*loggable);
-    }
-}
 //notify all observers of the subject with a loggable object
 void Subject::notifyObservers(const ILoggable& loggable) const {
     for (Observer* observer : observers) {
@@ -28,7 +28,7 @@ public:
     void detach(Observer* observer);
 
 protected:
-    void notifyObservers() const;
+    // Subclasses pass themselves: notifyObservers(*this)
     void notifyObservers(const ILoggable& loggable) const;
     void propagateObserversTo(Subject& target) const;
     const std::vector<Observer*>& getObservers() const;
@@ -2,6 +2,7 @@
 #include "../Command_processing/CommandProcessing.h"
 #include "../Orders/Orders.h"
 #include "../Game_Engine/GameEngine.h"
+#include "../Game_Engine/GameContext.h"
 #include "../Player/Player.h"
 #include "../Map/Map.h"
 
@@ -122,13 +123,14 @@ void testLoggingObserver() {
     OrdersList* ordersList = playerA.getOrdersList();
     ordersList->addObserver(&logObserver);
 
+    GameContext context;
     Order* deployOrder = new Deploy(3, &territoryAlpha, &playerA);
     ordersList->add(deployOrder);
-    deployOrder->execute();
+    deployOrder->execute(context);
 
     Order* advanceOrder = new Advance(2, &territoryAlpha, &territoryBeta, &playerA);
     ordersList->add(advanceOrder);
-    advanceOrder->execute();
+    advanceOrder->execute(context);
 
     reportSection("GameEngine State Logging");
 
@@ -9,11 +9,20 @@
 
 void testCards();
 void testLoadMaps();
+void testBatchLoadMaps();
+void testMalformedNumbers();
+void testCompiledMapRoundTrip();
+void testMapDistanceIndex();
+void testMapPartition();
+void testMapReload();
+void testMapRenumbering();
 void testOrdersLists();
 void testPlayers();
 //void testGameStates();
 void testStartupPhase();
 void testMainGameLoop();
+void testHeadlessGame();
+void testTournament();
 void testLoggingObserver();
 
 #define MAIN_DRIVER_INCLUDED
@@ -39,6 +48,13 @@ int main() {
     std::cout << "\n--- Testing Maps ---" << std::endl;
     try {
         testLoadMaps();
+        testBatchLoadMaps();
+        testMalformedNumbers();
+        testCompiledMapRoundTrip();
+        testMapDistanceIndex();
+        testMapPartition();
+        testMapReload();
+        testMapRenumbering();
     } catch (const std::exception& e) {
         std::cout << "Map test failed: " << e.what() << std::endl;
     }
@@ -75,6 +91,8 @@ int main() {
     std::cout << "\n--- Main Game Loop ---" << std::endl;
     try {
         testMainGameLoop();
+        testHeadlessGame();
+        testTournament();
     } catch (const std::exception& e) {
         std::cout << "Main Game Loop test failed: " << e.what() << std::endl;
     }
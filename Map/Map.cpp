@@ -1,198 +1,1574 @@
 #include "Map.h"
+#include "MapDistanceIndex.h"
+#include "MapPartition.h"
+#include "../ThreadPool/ThreadPool.h"
 #include <fstream>
 #include <sstream>
-#include <queue>
-#include <unordered_set>
+#include <algorithm>
+#include <chrono>
 #include <unordered_map>
+#include <string_view>
+#include <charconv>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <unordered_set>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
-Territory::Territory(int id, const std::string& name, Continent* continent)
-    : id(id), name(name), continent(continent), owner(nullptr), armies(0) {}
+Territory::Territory(int id, const std::string& name, Continent* continent, int x, int y)
+    : id(id), name(name), continent(continent), x(x), y(y), map(nullptr), owner(nullptr), armies(0), version(0), ownerVersion(0) {}
 
 // Copy constructor
 Territory::Territory(const Territory& other) 
-    : id(other.id), name(other.name), continent(other.continent), 
-      adjacents(other.adjacents), owner(other.owner), armies(other.armies) {}
+    : id(other.id), name(other.getName()), continent(other.continent), x(other.getX()), y(other.getY()), map(nullptr),
+      adjacents(other.getAdjacents().toVector()),
+      owner(other.getOwner()), armies(other.getArmies()), version(0), ownerVersion(0) {}
 
 // Assignment operator
 Territory& Territory::operator=(const Territory& other) {
     if (this != &other) {
+        std::vector<Territory*> otherAdjacents = other.getAdjacents().toVector();
         id = other.id;
-        name = other.name;
+        name = other.getName();
         continent = other.continent;
-        adjacents = other.adjacents;
-        owner = other.owner;
-        armies = other.armies;
+        x = other.getX();
+        y = other.getY();
+        map = nullptr;
+        adjacents.swap(otherAdjacents);
+        owner = other.getOwner();
+        armies = other.getArmies();
+        version++;
+        ownerVersion++;
     }
     return *this;
 }
 
 int Territory::getId() const { return id; }
-std::string Territory::getName() const { return name; }
+std::string_view Territory::getName() const { return map ? map->topology->names[id] : std::string_view(name); }
 Continent* Territory::getContinent() const { return continent; }
+int Territory::getX() const { return map ? map->topology->coordinates[2 * id] : x; }
+int Territory::getY() const { return map ? map->topology->coordinates[2 * id + 1] : y; }
 
 // Add an adjacent territory to this territory's adjacency list
 void Territory::addAdjacentTerritory(Territory* t) { adjacents.push_back(t); }
-const std::vector<Territory*>& Territory::getAdjacents() const { return adjacents; }
+TerritorySpan Territory::getAdjacents() const {
+    if (map && map->hasAdjacency()) return map->getAdjacents(id);
+    return TerritorySpan(adjacents.data(), adjacents.size());
+}
 
 // Set the owner of this territory
-void Territory::setOwner(Player* p) { owner = p; }
-Player* Territory::getOwner() const { return owner; }
+void Territory::setOwner(Player* p) {
+    if (map) map->getState().setOwner(id, p);
+    else {
+        if (owner != p) ownerVersion++;
+        owner = p;
+        version++;
+    }
+}
+Player* Territory::getOwner() const { return map ? map->getState().getOwner(id) : owner; }
 // Set the number of armies on this territory
-void Territory::setArmies(int n) { armies = n; }
-int Territory::getArmies() const { return armies; }
+void Territory::setArmies(int n) {
+    if (map) map->getState().setArmies(id, n);
+    else {
+        armies = n;
+        version++;
+    }
+}
+int Territory::getArmies() const { return map ? map->getState().getArmies(id) : armies; }
+uint32_t Territory::getVersion() const { return map ? map->getState().getVersion(id) : version; }
+uint32_t Territory::getOwnerVersion() const { return map ? map->getState().getOwnerVersion(id) : ownerVersion; }
 
-Continent::Continent(const std::string& name) : name(name) {}
+TerritoryState::TerritoryState() : membership(std::make_shared<Membership>()) {}
+
+// Copy constructor
+TerritoryState::TerritoryState(const TerritoryState& other)
+    : players(other.players), ownerIdx(other.ownerIdx), armies(other.armies), versions(other.versions),
+      ownerVersions(other.ownerVersions), membership(other.membership),
+      continentHolder(other.continentHolder), heldCount(other.heldCount) {}
+
+// Assignment operator
+TerritoryState& TerritoryState::operator=(const TerritoryState& other) {
+    if (this != &other) {
+        players = other.players;
+        ownerIdx = other.ownerIdx;
+        armies = other.armies;
+        versions = other.versions;
+        ownerVersions = other.ownerVersions;
+        membership = other.membership;
+        continentHolder = other.continentHolder;
+        heldCount = other.heldCount;
+    }
+    return *this;
+}
+
+// Membership is shared between copies; take a private copy before changing it
+TerritoryState::Membership& TerritoryState::editMembership() {
+    if (membership.use_count() > 1) membership = std::make_shared<Membership>(*membership);
+    return *membership;
+}
+
+void TerritoryState::addSlot(int id, Player* owner, int n) {
+    if (id < 0) return;
+    if (id >= (int)ownerIdx.size()) {
+        ownerIdx.resize(id + 1, kNoTerritory);
+        armies.resize(id + 1, 0);
+        versions.resize(id + 1, 0);
+        ownerVersions.resize(id + 1, 0);
+        editMembership().continentOf.resize(id + 1, -1);
+    } else {
+        assignContinent(id, -1);
+    }
+    ownerIdx[id] = kUnowned;
+    setOwner(id, owner);
+    armies[id] = n;
+}
+
+void TerritoryState::removeSlot(int id) {
+    if (id < 0 || id >= (int)ownerIdx.size()) return;
+    assignContinent(id, -1);
+    setOwner(id, nullptr);
+    ownerIdx[id] = kNoTerritory;
+    armies[id] = 0;
+}
+
+// newIds is a permutation of the ids; continent sizes and holders do not depend on ids
+void TerritoryState::renumber(const std::vector<int>& newIds) {
+    if (newIds.size() != ownerIdx.size()) return;
+    std::vector<int16_t> movedOwners(ownerIdx.size());
+    std::vector<int> movedArmies(armies.size());
+    std::vector<uint32_t> movedVersions(versions.size());
+    std::vector<uint32_t> movedOwnerVersions(ownerVersions.size());
+    std::vector<int> movedContinents(membership->continentOf.size());
+    for (size_t id = 0; id < newIds.size(); id++) {
+        movedOwners[newIds[id]] = ownerIdx[id];
+        movedArmies[newIds[id]] = armies[id];
+        movedVersions[newIds[id]] = versions[id];
+        movedOwnerVersions[newIds[id]] = ownerVersions[id];
+        movedContinents[newIds[id]] = membership->continentOf[id];
+    }
+    ownerIdx.swap(movedOwners);
+    armies.swap(movedArmies);
+    versions.swap(movedVersions);
+    ownerVersions.swap(movedOwnerVersions);
+    editMembership().continentOf.swap(movedContinents);
+}
+
+void TerritoryState::clear() {
+    players.clear();
+    ownerIdx.clear();
+    armies.clear();
+    versions.clear();
+    ownerVersions.clear();
+    membership = std::make_shared<Membership>();
+    continentHolder.clear();
+    heldCount.clear();
+}
+
+int TerritoryState::size() const { return (int)ownerIdx.size(); }
+
+Player* TerritoryState::getOwner(int id) const {
+    int idx = getOwnerIndex(id);
+    return idx >= 0 ? players[idx] : nullptr;
+}
+
+void TerritoryState::setOwner(int id, Player* p) {
+    if (id < 0 || id >= (int)ownerIdx.size()) return;
+    int16_t next = p ? indexFor(p) : kUnowned;
+    int16_t prev = ownerIdx[id];
+    int continent = membership->continentOf[id];
+    if (continent >= 0 && prev != next) {
+        countHeld(continent, prev, -1);
+        countHeld(continent, next, 1);
+    }
+    if (prev != next) ownerVersions[id]++;
+    ownerIdx[id] = next;
+    versions[id]++;
+}
+
+int TerritoryState::getArmies(int id) const {
+    if (id < 0 || id >= (int)armies.size()) return 0;
+    return armies[id];
+}
+
+void TerritoryState::setArmies(int id, int n) {
+    if (id < 0 || id >= (int)armies.size()) return;
+    armies[id] = n;
+    versions[id]++;
+}
+
+uint32_t TerritoryState::getVersion(int id) const {
+    if (id < 0 || id >= (int)versions.size()) return 0;
+    return versions[id];
+}
+
+uint32_t TerritoryState::getOwnerVersion(int id) const {
+    if (id < 0 || id >= (int)ownerVersions.size()) return 0;
+    return ownerVersions[id];
+}
+
+int TerritoryState::getOwnerIndex(int id) const {
+    if (id < 0 || id >= (int)ownerIdx.size()) return kUnowned;
+    return ownerIdx[id] >= 0 ? ownerIdx[id] : kUnowned;
+}
+
+int TerritoryState::findPlayerIndex(const Player* p) const {
+    for (size_t i = 0; i < players.size(); i++) {
+        if (players[i] == p) return (int)i;
+    }
+    return kUnowned;
+}
+
+const std::vector<Player*>& TerritoryState::getPlayers() const { return players; }
+
+// Player registry is tiny (one entry per player that ever owned a territory)
+int16_t TerritoryState::indexFor(Player* p) {
+    int idx = findPlayerIndex(p);
+    if (idx >= 0) return (int16_t)idx;
+    players.push_back(p);
+    heldCount.emplace_back(membership->continentSize.size(), 0);
+    return (int16_t)(players.size() - 1);
+}
+
+// Adjust one owner's count on a continent; the holder only changes when that
+// count reaches the continent's size or the current holder loses a territory
+void TerritoryState::countHeld(int continent, int16_t owner, int delta) {
+    if (owner < 0) return;
+    int& held = heldCount[owner][continent];
+    held += delta;
+    if (delta > 0 && held == membership->continentSize[continent]) continentHolder[continent] = owner;
+    else if (delta < 0 && continentHolder[continent] == owner) continentHolder[continent] = kUnowned;
+}
+
+int TerritoryState::addContinent() {
+    std::vector<int>& continentSize = editMembership().continentSize;
+    continentSize.push_back(0);
+    continentHolder.push_back(kUnowned);
+    for (std::vector<int>& counts : heldCount) counts.push_back(0);
+    return (int)continentSize.size() - 1;
+}
+
+// Move territory id into a continent (-1 for none). Membership changes only happen
+// while a map is being built, so the holders are recomputed over the players here
+void TerritoryState::assignContinent(int id, int continent) {
+    if (id < 0 || id >= (int)membership->continentOf.size() || continent >= (int)membership->continentSize.size()) return;
+    int previous = membership->continentOf[id];
+    if (previous == continent) return;
+    int16_t owner = ownerIdx[id];
+
+    Membership& m = editMembership();
+    std::vector<int>& continentSize = m.continentSize;
+    m.continentOf[id] = continent;
+    for (int c : {previous, continent}) {
+        if (c < 0) continue;
+        continentSize[c] += (c == continent) ? 1 : -1;
+        if (owner >= 0) heldCount[owner][c] += (c == continent) ? 1 : -1;
+        continentHolder[c] = kUnowned;
+        for (size_t p = 0; continentSize[c] > 0 && p < heldCount.size(); p++) {
+            if (heldCount[p][c] == continentSize[c]) continentHolder[c] = (int16_t)p;
+        }
+    }
+}
+
+int TerritoryState::getContinentOf(int id) const {
+    if (id < 0 || id >= (int)membership->continentOf.size()) return -1;
+    return membership->continentOf[id];
+}
+
+int TerritoryState::getContinentCount() const { return (int)membership->continentSize.size(); }
+
+int TerritoryState::getContinentOwnerIndex(int continent) const {
+    if (continent < 0 || continent >= (int)continentHolder.size()) return kUnowned;
+    return continentHolder[continent];
+}
+
+Player* TerritoryState::getContinentOwner(int continent) const {
+    int idx = getContinentOwnerIndex(continent);
+    return idx >= 0 ? players[idx] : nullptr;
+}
+
+int TerritoryState::countOwnedBy(const Player* p) const {
+    int idx = findPlayerIndex(p);
+    if (idx < 0) return 0;
+    int count = 0;
+    for (int16_t owner : ownerIdx) {
+        if (owner == idx) count++;
+    }
+    return count;
+}
+
+std::vector<int> TerritoryState::countByOwner() const {
+    std::vector<int> counts(players.size(), 0);
+    for (int16_t owner : ownerIdx) {
+        if (owner >= 0) counts[owner]++;
+    }
+    return counts;
+}
+
+Player* TerritoryState::getSoleOwner() const {
+    int sole = kNoTerritory;
+    for (int16_t owner : ownerIdx) {
+        if (owner == kNoTerritory) continue;
+        if (owner == kUnowned) return nullptr;
+        if (sole == kNoTerritory) sole = owner;
+        else if (owner != sole) return nullptr;
+    }
+    return sole >= 0 ? players[sole] : nullptr;
+}
+
+Continent::Continent(const std::string& name, int bonus) : name(name), bonus(bonus), map(nullptr), index(-1) {}
 
 // Copy constructor
 Continent::Continent(const Continent& other) 
-    : name(other.name), territories(other.territories) {}
+    : name(other.getName()), bonus(other.bonus), territories(other.territories), map(nullptr), index(-1) {}
 
 // Assignment operator
 Continent& Continent::operator=(const Continent& other) {
     if (this != &other) {
-        name = other.name;
+        name = other.getName();
+        bonus = other.bonus;
         territories = other.territories;
+        map = nullptr;
+        index = -1;
     }
     return *this;
 }
-std::string Continent::getName() const { return name; }
+std::string_view Continent::getName() const { return map ? map->topology->continentNames[index] : std::string_view(name); }
+int Continent::getBonus() const { return bonus; }
 
 // Add a territory to this continent
 void Continent::addTerritory(Territory* t) { territories.push_back(t); }
 const std::vector<Territory*>& Continent::getTerritories() const { return territories; }
 
-Map::Map() {}
+Map::Map() : topology(std::make_shared<MapTopology>()), handlesPending(false), looseTerritories(0), hasLoadReport(false) {}
 
 // Copy constructor
-Map::Map(const Map& other) {
-    for (auto c : other.continents) {
-        continents.push_back(new Continent(*c));
-    }
-    for (auto t : other.territories) {
-        territories.push_back(new Territory(*t));
-    }
+Map::Map(const Map& other) : handlesPending(false), looseTerritories(0), hasLoadReport(false) {
+    copyFrom(other);
 }
 
 // Assignment operator
 Map& Map::operator=(const Map& other) {
     if (this != &other) {
-        for (auto t : territories) delete t;
-        for (auto c : continents) delete c;
+        release();
         territories.clear();
         continents.clear();
-        
-        for (auto c : other.continents) {
-            continents.push_back(new Continent(*c));
+        territoryTable.clear();
+        continentIndex.clear();
+        handlesPending = false;
+        copyFrom(other);
+    }
+    return *this;
+}
+
+// Share the other map's topology and copy its state and continent handles. When every
+// territory is an ordinary member of this map their handles can be rebuilt from the
+// topology later; otherwise they are copied now, pointing at this map's objects
+// rather than at the original map's
+void Map::copyFrom(const Map& other) {
+    topology = other.topology;
+    state = other.state;
+    looseTerritories = other.looseTerritories;
+    hasLoadReport = other.hasLoadReport;
+    loadReport = other.loadReport;
+
+    continents.reserve(other.continents.size());
+    for (size_t i = 0; i < other.continents.size(); i++) {
+        const Continent* c = other.continents[i];
+        Continent* copy = arena.create<Continent>(std::string(), c->bonus);
+        copy->map = this;
+        copy->index = other.getContinentIndex(c);
+        continents.push_back(copy);
+        continentIndex[copy] = copy->index;
+    }
+
+    // Hand-built adjacency lives on the territories themselves, so it needs the eager copy too
+    if (looseTerritories == 0 && hasAdjacency()) {
+        handlesPending = true;
+        return;
+    }
+
+    other.ensureHandles();
+    arena.reserve(other.territories.size() * sizeof(Territory));
+    territories.reserve(other.territories.size());
+    territoryTable.assign(other.territoryTable.size(), nullptr);
+    const Continent* lastContinent = nullptr;
+    int index = -1;
+    for (const Territory* t : other.territories) {
+        // Territories usually arrive grouped by continent
+        if (t->continent != lastContinent) {
+            lastContinent = t->continent;
+            index = other.getContinentIndex(t->continent);
         }
-        for (auto t : other.territories) {
-            territories.push_back(new Territory(*t));
+        Continent* continent = index >= 0 ? continents[index] : t->continent;
+        Territory* copy;
+        if (t->map == &other) {
+            // Name, coordinates, owner and armies are read through the map
+            copy = arena.create<Territory>(t->id, std::string(), continent);
+            copy->map = this;
+            territoryTable[t->id] = copy;
+        } else {
+            copy = arena.create<Territory>(*t);
+            copy->continent = continent;
+        }
+        territories.push_back(copy);
+        if (index >= 0) continent->territories.push_back(territories.back());
+    }
+
+    // Hand-built adjacency (no CSR table yet) has to follow the territories across
+    for (size_t i = 0; i < other.territories.size(); i++) {
+        const Territory* t = other.territories[i];
+        if (t->map != &other || t->adjacents.empty()) continue;
+        std::vector<Territory*>& adjacents = territories[i]->adjacents;
+        adjacents.reserve(t->adjacents.size());
+        for (Territory* n : t->adjacents) {
+            bool local = n && n->map == &other && other.getTerritory(n->id) == n;
+            adjacents.push_back(local ? territoryTable[n->id] : n);
         }
     }
-    return *this;
 }
 
 Map::~Map() {
-    for (auto t : territories) delete t;
-    for (auto c : continents) delete c;
+    release();
+}
+
+// Delete the individually allocated territories and continents, then give the arena
+// back in one go. Arena territories bound to the map hold no memory of their own, so
+// running their destructors frees nothing.
+void Map::release() {
+    for (auto t : territories) {
+        if (arena.owns(t)) t->~Territory();
+        else delete t;
+    }
+    for (auto c : continents) {
+        if (arena.owns(c)) c->~Continent();
+        else delete c;
+    }
+    arena.release();
+}
+
+MapTopology::MapTopology(const MapTopology& other)
+    : territoryIds(other.territoryIds), names(other.names.size()), continentNames(other.continentNames.size()),
+      coordinates(other.coordinates), nameSlots(other.nameSlots), adjacencyOffsets(other.adjacencyOffsets),
+      adjacencyTargets(other.adjacencyTargets) {
+    size_t bytes = 0;
+    for (std::string_view name : other.names) bytes += name.size();
+    for (std::string_view name : other.continentNames) bytes += name.size();
+    strings.reserve(bytes);
+    for (size_t i = 0; i < names.size(); i++) names[i] = strings.copy(other.names[i]);
+    for (size_t i = 0; i < continentNames.size(); i++) continentNames[i] = strings.copy(other.continentNames[i]);
 }
 
-// Add a continent to the map
-void Map::addContinent(Continent* c) { continents.push_back(c); }
-// Add a territory to the map
-void Map::addTerritory(Territory* t) { territories.push_back(t); }
+namespace {
+    // FNV-1a; deterministic so the name index can be stored in compiled maps
+    inline uint64_t hashName(std::string_view name) {
+        uint64_t h = 14695981039346656037ull;
+        for (unsigned char ch : name) {
+            h ^= ch;
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    // Positions stably sorted by continent index, so objects created in this order sit
+    // continent by continent; positions without a continent (-1) come last
+    std::vector<int> groupByContinent(const std::vector<int>& continentOf, size_t continentCount) {
+        std::vector<int> next(continentCount + 2, 0);
+        for (int c : continentOf) next[(c >= 0 ? c : (int)continentCount) + 1]++;
+        for (size_t c = 1; c < next.size(); c++) next[c] += next[c - 1];
+        std::vector<int> order(continentOf.size());
+        for (size_t i = 0; i < continentOf.size(); i++) {
+            int c = continentOf[i] >= 0 ? continentOf[i] : (int)continentCount;
+            order[next[c]++] = (int)i;
+        }
+        return order;
+    }
+}
+
+void Map::ensureHandles() const {
+    if (handlesPending) buildHandles();
+}
+
+// One handle per registered territory, in the original order; name, coordinates,
+// owner and armies are all read through the map
+void Map::buildHandles() const {
+    handlesPending = false;
+    Map* self = const_cast<Map*>(this);
+    const std::vector<int>& ids = topology->territoryIds;
+    std::vector<int> continentOf(ids.size());
+    for (size_t i = 0; i < ids.size(); i++) continentOf[i] = state.getContinentOf(ids[i]);
+
+    std::vector<Territory*> created(ids.size());
+    arena.reserve(ids.size() * sizeof(Territory));
+    for (int i : groupByContinent(continentOf, continents.size())) {
+        Continent* continent = continentOf[i] >= 0 ? continents[continentOf[i]] : nullptr;
+        created[i] = arena.create<Territory>(ids[i], std::string(), continent);
+        created[i]->map = self;
+    }
+
+    territories.reserve(ids.size());
+    territoryTable.assign(topology->names.size(), nullptr);
+    for (size_t i = 0; i < ids.size(); i++) {
+        Territory* t = created[i];
+        territoryTable[ids[i]] = t;
+        territories.push_back(t);
+        if (t->continent) t->continent->territories.push_back(t);
+    }
+}
+
+// Create the territories in the arena grouped by continent, then register them in the
+// order given. The name index is either rebuilt once at the end or left to the caller.
+void Map::addTerritories(const std::vector<TerritorySeed>& seeds, bool buildNameIndex) {
+    std::vector<int> continentOf(seeds.size());
+    size_t nameBytes = 0;
+    for (size_t i = 0; i < seeds.size(); i++) {
+        continentOf[i] = seeds[i].continent;
+        nameBytes += seeds[i].name.size();
+    }
+
+    std::vector<Territory*> created(seeds.size());
+    arena.reserve(seeds.size() * sizeof(Territory));
+    for (int i : groupByContinent(continentOf, continents.size())) {
+        const TerritorySeed& seed = seeds[i];
+        Continent* continent = seed.continent >= 0 ? continents[seed.continent] : nullptr;
+        created[i] = arena.create<Territory>(seed.id, std::string(), continent, seed.x, seed.y);
+    }
+
+    territories.reserve(territories.size() + seeds.size());
+    editTopology().strings.reserve(nameBytes);
+    for (size_t i = 0; i < seeds.size(); i++) {
+        Territory* t = created[i];
+        if (t->continent) t->continent->addTerritory(t);
+        registerTerritory(t, seeds[i].name);
+    }
+
+    if (buildNameIndex) {
+        size_t capacity = 16;
+        while (territories.size() * 2 > capacity) capacity *= 2;
+        rebuildNameIndex(capacity);
+    }
+}
+
+// Topology is shared between copies; take a private copy before changing it
+MapTopology& Map::editTopology() {
+    if (topology.use_count() > 1) topology = std::make_shared<MapTopology>(*topology);
+    topology->distanceIndex.reset();
+    topology->partition.reset();
+    return *topology;
+}
+
+// Insert territories[position] into the name index; a later duplicate replaces the earlier entry
+void Map::indexName(size_t position) {
+    std::vector<int>& nameSlots = editTopology().nameSlots;
+    size_t mask = nameSlots.size() - 1;
+    std::string_view name = territories[position]->getName();
+    for (size_t slot = hashName(name) & mask;; slot = (slot + 1) & mask) {
+        int& entry = nameSlots[slot];
+        if (entry < 0 || territories[entry]->getName() == name) {
+            entry = (int)position;
+            return;
+        }
+    }
+}
+
+// Empty a slot of the name index, pulling later entries of the same probe run back
+// into the gap so lookups never stop early at it
+void Map::unindexName(size_t slot) {
+    std::vector<int>& nameSlots = editTopology().nameSlots;
+    size_t mask = nameSlots.size() - 1;
+    size_t hole = slot;
+    for (size_t next = (hole + 1) & mask; nameSlots[next] >= 0; next = (next + 1) & mask) {
+        size_t home = hashName(territories[nameSlots[next]]->getName()) & mask;
+        bool reachable = hole <= next ? (home <= hole || home > next) : (home <= hole && home > next);
+        if (reachable) {
+            nameSlots[hole] = nameSlots[next];
+            hole = next;
+        }
+    }
+    nameSlots[hole] = -1;
+}
+
+// Take a territory out of the map. The last territory moves into its place in
+// getTerritories(), so the name index only needs two entries changed
+void Map::removeTerritory(int id) {
+    Territory* t = getTerritory(id);
+    if (!t) return;
+    MapTopology& topo = editTopology();
+    std::vector<int>& nameSlots = topo.nameSlots;
+    auto slotOf = [&](const Territory* target) {
+        size_t mask = nameSlots.size() - 1;
+        for (size_t slot = hashName(target->getName()) & mask; !nameSlots.empty(); slot = (slot + 1) & mask) {
+            if (nameSlots[slot] < 0) break;
+            if (territories[nameSlots[slot]] == target) return slot;
+        }
+        return nameSlots.size();
+    };
+
+    // A territory shadowed by a duplicate name is not in the index
+    size_t slot = slotOf(t);
+    size_t position = slot < nameSlots.size() ? (size_t)nameSlots[slot]
+                                              : std::find(territories.begin(), territories.end(), t) - territories.begin();
+    if (slot < nameSlots.size()) unindexName(slot);
+    size_t last = territories.size() - 1;
+    if (position != last) {
+        size_t movedSlot = slotOf(territories[last]);
+        if (movedSlot < nameSlots.size()) nameSlots[movedSlot] = (int)position;
+        territories[position] = territories[last];
+        topo.territoryIds[position] = topo.territoryIds[last];
+    }
+    territories.pop_back();
+    topo.territoryIds.pop_back();
+
+    if (t->continent) {
+        std::vector<Territory*>& members = t->continent->territories;
+        auto it = std::find(members.begin(), members.end(), t);
+        if (it != members.end()) members.erase(it);
+    }
+    state.removeSlot(id);
+    territoryTable[id] = nullptr;
+    topo.names[id] = std::string_view();
+    topo.coordinates[2 * id] = 0;
+    topo.coordinates[2 * id + 1] = 0;
+    if (arena.owns(t)) t->~Territory();
+    else delete t;
+}
+
+// Re-insert every territory into a fresh table with the given power-of-two capacity
+void Map::rebuildNameIndex(size_t capacity) {
+    editTopology().nameSlots.assign(capacity, -1);
+    for (size_t i = 0; i < territories.size(); i++) indexName(i);
+}
+
+// Add a continent to the map; territories already in the map join its holder cache
+void Map::addContinent(Continent* c) {
+    ensureHandles();
+    hasLoadReport = false;
+    registerContinent(c, c->getName());
+}
+
+// The name moves into the topology's string table
+void Map::registerContinent(Continent* c, std::string_view name) {
+    int index = state.addContinent();
+    continents.push_back(c);
+    continentIndex[c] = index;
+    MapTopology& topo = editTopology();
+    if ((int)topo.continentNames.size() <= index) topo.continentNames.resize(index + 1);
+    topo.continentNames[index] = topo.strings.copy(name);
+    std::string().swap(c->name);
+    c->map = this;
+    c->index = index;
+    for (Territory* t : c->getTerritories()) {
+        if (t->map == this && t->continent == c) state.assignContinent(t->id, index);
+    }
+}
+
+int Map::getContinentIndex(const Continent* c) const {
+    auto it = continentIndex.find(c);
+    return it != continentIndex.end() ? it->second : -1;
+}
+
+Player* Map::getContinentOwner(const Continent* c) const {
+    return state.getContinentOwner(getContinentIndex(c));
+}
+// Add a territory to the map; its owner and armies move into the map's state arrays
+void Map::addTerritory(Territory* t) {
+    ensureHandles();
+    hasLoadReport = false;
+    registerTerritory(t, t->getName());
+    // Keep the index at most half full
+    size_t slots = topology->nameSlots.size();
+    if (territories.size() * 2 > slots) {
+        rebuildNameIndex(std::max<size_t>(16, slots * 2));
+    } else {
+        indexName(territories.size() - 1);
+    }
+}
+
+void Map::registerTerritory(Territory* t, std::string_view name) {
+    territories.push_back(t);
+    int id = t->getId();
+    if (id < 0 || (t->continent && getContinentIndex(t->continent) < 0)) looseTerritories++;
+    if (id < 0) return;
+    if (id >= (int)territoryTable.size()) territoryTable.resize(id + 1, nullptr);
+    territoryTable[id] = t;
+    state.addSlot(id, t->getOwner(), t->getArmies());
+    state.assignContinent(id, getContinentIndex(t->continent));
+
+    // Name and coordinates move into the topology
+    MapTopology& topo = editTopology();
+    topo.territoryIds.push_back(id);
+    if ((int)topo.names.size() <= id) {
+        topo.names.resize(id + 1);
+        topo.coordinates.resize(2 * (id + 1), 0);
+    }
+    int x = t->getX();
+    int y = t->getY();
+    topo.names[id] = topo.strings.copy(name);
+    topo.coordinates[2 * id] = x;
+    topo.coordinates[2 * id + 1] = y;
+    std::string().swap(t->name);
+    t->map = this;
+}
 
 // Find and return a territory by its ID
 Territory* Map::getTerritory(int id) const {
-    for (auto t : territories) {
-        if (t->getId() == id) return t;
+    ensureHandles();
+    if (id < 0 || id >= (int)territoryTable.size()) return nullptr;
+    return territoryTable[id];
+}
+
+// Find and return a territory by its name; later duplicates shadow earlier ones
+Territory* Map::getTerritoryByName(std::string_view name) const {
+    ensureHandles();
+    const std::vector<int>& nameSlots = topology->nameSlots;
+    if (nameSlots.empty()) return nullptr;
+    size_t mask = nameSlots.size() - 1;
+    for (size_t slot = hashName(name) & mask;; slot = (slot + 1) & mask) {
+        int entry = nameSlots[slot];
+        if (entry < 0) return nullptr;
+        if (territories[entry]->getName() == name) return territories[entry];
     }
-    return nullptr;
 }
 
-const std::vector<Continent*>& Map::getContinents() const { return continents; }
-const std::vector<Territory*>& Map::getTerritories() const { return territories; }
+const std::vector<Continent*>& Map::getContinents() const {
+    ensureHandles();
+    return continents;
+}
+
+const std::vector<Territory*>& Map::getTerritories() const {
+    ensureHandles();
+    return territories;
+}
+
+void Map::buildAdjacency(const std::vector<std::pair<int, int>>& edges) {
+    ensureHandles();
+    hasLoadReport = false;
+    const int rows = (int)territoryTable.size();
+    auto inMap = [&](int id) { return id >= 0 && id < rows && territoryTable[id] != nullptr; };
+
+    // Gather every undirected edge: the ones passed in plus any hand-built local lists
+    std::vector<std::pair<int, int>> localEdges;
+    for (Territory* t : territories) {
+        for (Territory* n : t->adjacents) {
+            if (n && inMap(n->getId()) && territoryTable[n->getId()] == n) {
+                localEdges.push_back({t->getId(), n->getId()});
+            }
+        }
+    }
+
+    const std::vector<std::pair<int, int>>* edgeLists[] = {&edges, &localEdges};
+    MapTopology& topo = editTopology();
+    std::vector<int>& adjacencyOffsets = topo.adjacencyOffsets;
+    std::vector<int>& adjacencyTargets = topo.adjacencyTargets;
+    adjacencyOffsets.assign(rows + 1, 0);
+    for (const auto* list : edgeLists) {
+        for (const auto& e : *list) {
+            if (!inMap(e.first) || !inMap(e.second)) continue;
+            adjacencyOffsets[e.first + 1]++;
+            adjacencyOffsets[e.second + 1]++;
+        }
+    }
+    for (int r = 0; r < rows; r++) adjacencyOffsets[r + 1] += adjacencyOffsets[r];
+
+    adjacencyTargets.assign(adjacencyOffsets[rows], 0);
+    std::vector<int> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (const auto* list : edgeLists) {
+        for (const auto& e : *list) {
+            if (!inMap(e.first) || !inMap(e.second)) continue;
+            adjacencyTargets[cursor[e.first]++] = e.second;
+            adjacencyTargets[cursor[e.second]++] = e.first;
+        }
+    }
+
+    // Drop duplicate edges (files usually list both directions) and keep the first of
+    // each in place, so a row lists neighbours in file order like the loader always did
+    std::vector<int> seenInRow(rows, -1);
+    int write = 0;
+    int readBegin = 0;
+    for (int r = 0; r < rows; r++) {
+        int readEnd = adjacencyOffsets[r + 1];
+        int rowStart = write;
+        for (int i = readBegin; i < readEnd; i++) {
+            int target = adjacencyTargets[i];
+            if (seenInRow[target] != r) {
+                seenInRow[target] = r;
+                adjacencyTargets[write++] = target;
+            }
+        }
+        adjacencyOffsets[r] = rowStart;
+        readBegin = readEnd;
+    }
+    adjacencyOffsets[rows] = write;
+    adjacencyTargets.resize(write);
+    adjacencyTargets.shrink_to_fit();
+
+    for (Territory* t : territories) {
+        if (t->map == this) std::vector<Territory*>().swap(t->adjacents);
+    }
+}
+
+TerritorySpan Map::getAdjacents(int id) const {
+    ensureHandles();
+    const std::vector<int>& adjacencyOffsets = topology->adjacencyOffsets;
+    const std::vector<int>& adjacencyTargets = topology->adjacencyTargets;
+    if (id < 0 || id + 1 >= (int)adjacencyOffsets.size()) return TerritorySpan();
+    int begin = adjacencyOffsets[id];
+    return TerritorySpan(adjacencyTargets.data() + begin, adjacencyOffsets[id + 1] - begin, territoryTable.data());
+}
+
+const std::vector<int>& Map::getAdjacencyOffsets() const { return topology->adjacencyOffsets; }
+const std::vector<int>& Map::getAdjacencyTargets() const { return topology->adjacencyTargets; }
+bool Map::hasAdjacency() const { return topology->adjacencyOffsets.size() == topology->names.size() + 1; }
+
+const MapDistanceIndex& Map::getDistanceIndex() const {
+    if (!topology->distanceIndex) topology->distanceIndex = std::make_shared<MapDistanceIndex>(*this);
+    return *topology->distanceIndex;
+}
+
+const MapPartition& Map::getPartition() const {
+    if (!topology->partition) topology->partition = std::make_shared<MapPartition>(*this);
+    return *topology->partition;
+}
+
+TerritoryState& Map::getState() { return state; }
+const TerritoryState& Map::getState() const { return state; }
+
+namespace {
+    // Bit helpers over a vector of 64-bit words indexed by dense territory id
+    inline bool testBit(const std::vector<uint64_t>& bits, int id) {
+        return (bits[id >> 6] >> (id & 63)) & 1u;
+    }
+    inline void setBit(std::vector<uint64_t>& bits, int id) {
+        bits[id >> 6] |= uint64_t(1) << (id & 63);
+    }
+    inline void clearBit(std::vector<uint64_t>& bits, int id) {
+        bits[id >> 6] &= ~(uint64_t(1) << (id & 63));
+    }
+
+    // Union-find with path halving and union by size
+    int findRoot(std::vector<int>& parent, int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+    // Returns true when a and b were in different sets
+    bool unite(std::vector<int>& parent, std::vector<int>& size, int a, int b) {
+        a = findRoot(parent, a);
+        b = findRoot(parent, b);
+        if (a == b) return false;
+        if (size[a] < size[b]) std::swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+        return true;
+    }
+
+    double elapsedMs(std::chrono::steady_clock::time_point since) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+    }
+
+    // Below this size, spinning up pool workers costs more than the per-continent BFS
+    const size_t kParallelValidationThreshold = 20000;
+}
+
+bool MapValidationReport::isValid() const {
+    return connected && continentsConnected && uniqueContinents;
+}
 
 // Validate the map structure for game requirements
-bool Map::validate() const {
-    bool graphConnected = isConnectedGraph();
-    bool continentConnected = continentsAreConnected();
-    bool uniqueContinents = territoriesHaveUniqueContinent();
-    return graphConnected && continentConnected && uniqueContinents;
+bool Map::validate(MapValidationReport* report, bool forceFullCheck) const {
+    if (hasLoadReport && !forceFullCheck) {
+        if (report) *report = loadReport;
+        return loadReport.isValid();
+    }
+
+    ensureHandles();
+    MapValidationReport result;
+
+    auto start = std::chrono::steady_clock::now();
+    result.connected = isConnectedGraph();
+    result.connectedMs = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    result.continentsConnected = continentsAreConnected();
+    result.continentsMs = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    result.uniqueContinents = territoriesHaveUniqueContinent();
+    result.uniqueContinentsMs = elapsedMs(start);
+
+    if (report) *report = result;
+    return result.isValid();
 }
 
-static bool isTerritoriesConnected(const std::vector<Territory*>& nodes) {
+// BFS over the CSR table restricted to the given territories. The bitsets are
+// caller-owned scratch sized to the id table and are left cleared on return.
+bool Map::isSubgraphConnected(const std::vector<Territory*>& nodes, std::vector<uint64_t>& allowed,
+                              std::vector<uint64_t>& visited, std::vector<int>& frontier) const {
+    const std::vector<int>& adjacencyOffsets = topology->adjacencyOffsets;
+    const std::vector<int>& adjacencyTargets = topology->adjacencyTargets;
     if (nodes.empty()) return true;
-    std::unordered_set<int> allowed;
-    allowed.reserve(nodes.size());
+    if (!nodes[0]) return false;
+    const int idCount = (int)territoryTable.size();
     for (const Territory* t : nodes) {
-        if (t) {
-            allowed.insert(t->getId());
+        if (t && t->getId() >= 0 && t->getId() < idCount) {
+            setBit(allowed, t->getId());
         }
     }
 
-    std::unordered_set<int> visited;
-    std::queue<Territory*> q;
-    q.push(nodes[0]);
-    visited.insert(nodes[0]->getId());
+    size_t visitedCount = 0;
+    frontier.clear();
+    int first = nodes[0]->getId();
+    if (first >= 0 && first < idCount) {
+        setBit(visited, first);
+        frontier.push_back(first);
+        visitedCount = 1;
+    }
 
-    while (!q.empty()) {
-        Territory* cur = q.front(); q.pop();
-        for (auto n : cur->getAdjacents()) {
-            if (!n) {
+    for (size_t head = 0; head < frontier.size(); head++) {
+        int cur = frontier[head];
+        if (cur + 1 >= (int)adjacencyOffsets.size()) continue;
+        for (int i = adjacencyOffsets[cur]; i < adjacencyOffsets[cur + 1]; i++) {
+            int nid = adjacencyTargets[i];
+            if (!testBit(allowed, nid) || testBit(visited, nid)) {
                 continue;
             }
-            int nid = n->getId();
-            if (allowed.count(nid) == 0) {
-                continue;
-            }
-            if (visited.insert(nid).second) {
-                q.push(n);
-            }
+            setBit(visited, nid);
+            frontier.push_back(nid);
+            visitedCount++;
         }
     }
-    return visited.size() == nodes.size();
+
+    for (const Territory* t : nodes) {
+        if (t && t->getId() >= 0 && t->getId() < idCount) clearBit(allowed, t->getId());
+    }
+    for (int id : frontier) clearBit(visited, id);
+    return visitedCount == nodes.size();
 }
 
-// Check if the map forms a connected graph
+// Check if the map forms a connected graph: union-find over every CSR edge
 bool Map::isConnectedGraph() const {
-    return isTerritoriesConnected(territories);
+    const std::vector<int>& adjacencyOffsets = topology->adjacencyOffsets;
+    const std::vector<int>& adjacencyTargets = topology->adjacencyTargets;
+    if (territories.empty()) return true;
+    const int idCount = (int)territoryTable.size();
+    if ((int)adjacencyOffsets.size() != idCount + 1) return territories.size() == 1;
+
+    std::vector<int> parent(idCount);
+    std::vector<int> size(idCount, 1);
+    for (int id = 0; id < idCount; id++) parent[id] = id;
+
+    for (int id = 0; id < idCount; id++) {
+        for (int i = adjacencyOffsets[id]; i < adjacencyOffsets[id + 1]; i++) {
+            if (adjacencyTargets[i] > id) unite(parent, size, id, adjacencyTargets[i]);
+        }
+    }
+
+    int root = -1;
+    for (const Territory* t : territories) {
+        int id = t->getId();
+        if (id < 0 || id >= idCount || territoryTable[id] != t) return false;
+        int r = findRoot(parent, id);
+        if (root == -1) root = r;
+        else if (r != root) return false;
+    }
+    return true;
 }
 
-// Check if each continent is a connected subgraph
+// Check if each continent is a connected subgraph. Large maps spread the
+// continents over the shared thread pool, one scratch set per worker.
 bool Map::continentsAreConnected() const {
     for (auto c : continents) {
         if (c->getTerritories().empty()) {
             return false;
         }
-        if (!isTerritoriesConnected(c->getTerritories())) {
-            return false;
+    }
+
+    const size_t words = (territoryTable.size() + 63) / 64;
+    bool parallel = territories.size() >= kParallelValidationThreshold && continents.size() > 1;
+    size_t workers = parallel ? std::min(continents.size(), ThreadPool::shared().size() + 1) : 1;
+
+    std::vector<char> connected(continents.size(), 0);
+    auto checkSlice = [&](size_t slice) {
+        std::vector<uint64_t> allowed(words, 0);
+        std::vector<uint64_t> visited(words, 0);
+        std::vector<int> frontier;
+        for (size_t i = slice; i < continents.size(); i += workers) {
+            connected[i] = isSubgraphConnected(continents[i]->getTerritories(), allowed, visited, frontier);
         }
+    };
+
+    if (parallel) {
+        ThreadPool::shared().parallelFor(workers, checkSlice);
+    } else {
+        checkSlice(0);
     }
-    return true;
+    return std::all_of(connected.begin(), connected.end(), [](char ok) { return ok != 0; });
 }
 
 // Check if each territory belongs to exactly one continent
 bool Map::territoriesHaveUniqueContinent() const {
-    std::unordered_set<int> ids;
+    int maxId = -1;
     for (auto c : continents) {
         for (auto t : c->getTerritories()) {
-            if (!ids.insert(t->getId()).second) return false;
+            if (t->getId() < 0) return false;
+            maxId = std::max(maxId, t->getId());
+        }
+    }
+
+    std::vector<uint64_t> seen((maxId + 64) / 64, 0);
+    for (auto c : continents) {
+        for (auto t : c->getTerritories()) {
+            if (testBit(seen, t->getId())) return false;
+            setBit(seen, t->getId());
+        }
+    }
+    return true;
+}
+
+namespace {
+    inline uint64_t linkKey(int a, int b) {
+        if (a > b) std::swap(a, b);
+        return (uint64_t)a << 32 | (uint32_t)b;
+    }
+
+    // Undirected id pairs, smaller id first, without repeats
+    void normalizeEdges(std::vector<std::pair<int, int>>& edges) {
+        for (auto& e : edges) {
+            if (e.first > e.second) std::swap(e.first, e.second);
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    }
+}
+
+std::unordered_map<uint64_t, int> Map::countContinentLinks() const {
+    std::unordered_map<uint64_t, int> links;
+    const std::vector<int>& offsets = topology->adjacencyOffsets;
+    const std::vector<int>& targets = topology->adjacencyTargets;
+    for (int id = 0; id + 1 < (int)offsets.size(); id++) {
+        int from = state.getContinentOf(id);
+        for (int i = offsets[id]; i < offsets[id + 1]; i++) {
+            int to = state.getContinentOf(targets[i]);
+            if (targets[i] > id && from >= 0 && to >= 0 && from != to) links[linkKey(from, to)]++;
         }
     }
+    return links;
+}
+
+// Rewrite the CSR table with directed (row, target) entries dropped and added. Runs of
+// untouched rows are copied in one block each, and only the touched rows are rebuilt:
+// kept entries stay in order and added ones follow in the order they were given
+void Map::spliceAdjacency(std::vector<std::pair<int, int>>& drops, std::vector<std::pair<int, int>>& adds) {
+    MapTopology& topo = editTopology();
+    const std::vector<int>& offsets = topo.adjacencyOffsets;
+    const std::vector<int>& targets = topo.adjacencyTargets;
+    std::sort(drops.begin(), drops.end());
+    std::stable_sort(adds.begin(), adds.end(), [](const std::pair<int, int>& x, const std::pair<int, int>& y) {
+        return x.first < y.first;
+    });
+
+    const int oldRows = (int)offsets.size() - 1;
+    const int rows = (int)topo.names.size();
+    auto rowBegin = [&](int row) { return offsets[std::min(row, oldRows)]; };
+    std::vector<int> newOffsets(rows + 1, 0);
+    std::vector<int> newTargets;
+    newTargets.reserve(targets.size() + adds.size());
+
+    size_t d = 0;
+    size_t a = 0;
+    for (int row = 0; row < rows;) {
+        int touched = std::min(d < drops.size() ? drops[d].first : rows, a < adds.size() ? adds[a].first : rows);
+        int shift = (int)newTargets.size() - rowBegin(row);
+        for (int r = row; r < touched; r++) newOffsets[r] = rowBegin(r) + shift;
+        newTargets.insert(newTargets.end(), targets.begin() + rowBegin(row), targets.begin() + rowBegin(touched));
+        if (touched >= rows) break;
+
+        newOffsets[touched] = (int)newTargets.size();
+        size_t dropEnd = d;
+        while (dropEnd < drops.size() && drops[dropEnd].first == touched) dropEnd++;
+        size_t addEnd = a;
+        while (addEnd < adds.size() && adds[addEnd].first == touched) addEnd++;
+        auto dropped = [&](int target) {
+            return std::binary_search(drops.begin() + d, drops.begin() + dropEnd, std::make_pair(touched, target));
+        };
+        for (int i = rowBegin(touched); i < rowBegin(touched + 1); i++) {
+            if (!dropped(targets[i])) newTargets.push_back(targets[i]);
+        }
+        for (; a < addEnd; a++) {
+            int target = adds[a].second;
+            auto row = newTargets.begin() + newOffsets[touched];
+            if (dropped(target) || std::find(row, newTargets.end(), target) != newTargets.end()) continue;
+            newTargets.push_back(target);
+        }
+        d = dropEnd;
+        a = addEnd;
+        row = touched + 1;
+    }
+    newOffsets[rows] = (int)newTargets.size();
+    topo.adjacencyOffsets.swap(newOffsets);
+    topo.adjacencyTargets.swap(newTargets);
+}
+
+bool Map::applyDiff(const MapDiff& diff, MapValidationReport* report) {
+    ensureHandles();
+    if (!hasAdjacency()) buildAdjacency({});
+    const bool wasValid = hasLoadReport && loadReport.isValid() && looseTerritories == 0;
+    std::unordered_map<uint64_t, int> links = topology->continentLinks ? *topology->continentLinks : countContinentLinks();
+    // Private topology up front, so the names read below stay put while the map changes
+    editTopology();
+
+    std::unordered_map<std::string_view, int> continentByName;
+    for (Continent* c : continents) continentByName[c->getName()] = c->index;
+    for (const MapDiff::ContinentEntry& entry : diff.changedBonuses) {
+        auto it = continentByName.find(entry.name);
+        if (it != continentByName.end()) continents[it->second]->bonus = entry.bonus;
+    }
+    std::vector<int> affected;      // continents to check again
+    for (const MapDiff::ContinentEntry& entry : diff.addedContinents) {
+        if (continentByName.count(entry.name)) continue;
+        Continent* c = arena.create<Continent>(std::string(), entry.bonus);
+        registerContinent(c, entry.name);
+        continentByName[c->getName()] = c->index;
+        affected.push_back(c->index);
+    }
+    auto continentOf = [&](const std::string& name) {
+        auto it = continentByName.find(name);
+        return it != continentByName.end() ? it->second : -1;
+    };
+    auto idOf = [&](const std::string& name) {
+        Territory* t = getTerritoryByName(name);
+        return t ? t->id : -1;
+    };
+
+    // Edges whose continent pair may change: everything around removed and moved
+    // territories, plus the removed edges. Their old links are taken out here and
+    // whatever is left of them is counted back in once the table is patched
+    std::vector<int> removedIds;
+    for (const std::string& name : diff.removedTerritories) {
+        int id = idOf(name);
+        if (id >= 0) removedIds.push_back(id);
+    }
+    std::vector<std::pair<int, int>> moves;         // id, new continent
+    for (const MapDiff::TerritoryEntry& entry : diff.changedTerritories) {
+        int id = idOf(entry.name);
+        if (id < 0) continue;
+        MapTopology& topo = *topology;
+        topo.coordinates[2 * id] = entry.x;
+        topo.coordinates[2 * id + 1] = entry.y;
+        int continent = continentOf(entry.continent);
+        if (continent >= 0 && continent != state.getContinentOf(id)) moves.push_back({id, continent});
+    }
+    std::vector<std::pair<int, int>> removedEdges;
+    for (const auto& edge : diff.removedEdges) {
+        int a = idOf(edge.first);
+        int b = idOf(edge.second);
+        if (a >= 0 && b >= 0) removedEdges.push_back({a, b});
+    }
+
+    const std::vector<int>& offsets = topology->adjacencyOffsets;
+    const std::vector<int>& targets = topology->adjacencyTargets;
+    std::vector<std::pair<int, int>> relinked = removedEdges;
+    std::vector<int> movedIds;
+    for (const auto& move : moves) movedIds.push_back(move.first);
+    for (const std::vector<int>* ids : {&removedIds, &movedIds}) {
+        for (int id : *ids) {
+            for (int i = offsets[id]; i < offsets[id + 1]; i++) relinked.push_back({id, targets[i]});
+        }
+    }
+    normalizeEdges(relinked);
+    auto countLinks = [&](const std::vector<std::pair<int, int>>& edges, int delta) {
+        for (const auto& e : edges) {
+            int from = state.getContinentOf(e.first);
+            int to = state.getContinentOf(e.second);
+            if (from < 0 || to < 0 || from == to) continue;
+            auto it = links.emplace(linkKey(from, to), 0).first;
+            if ((it->second += delta) <= 0) links.erase(it);
+        }
+    };
+    countLinks(relinked, -1);
+    for (const auto& e : removedEdges) {
+        affected.push_back(state.getContinentOf(e.first));
+        affected.push_back(state.getContinentOf(e.second));
+    }
+
+    std::vector<std::pair<int, int>> drops;
+    std::vector<std::pair<int, int>> adds;
+    for (const auto& e : removedEdges) {
+        drops.push_back(e);
+        drops.push_back({e.second, e.first});
+    }
+    for (int id : removedIds) {
+        affected.push_back(state.getContinentOf(id));
+        for (int i = offsets[id]; i < offsets[id + 1]; i++) {
+            drops.push_back({id, targets[i]});
+            drops.push_back({targets[i], id});
+        }
+        removeTerritory(id);
+    }
+
+    for (const auto& move : moves) {
+        Territory* t = territoryTable[move.first];
+        affected.push_back(state.getContinentOf(move.first));
+        affected.push_back(move.second);
+        if (t->continent) {
+            std::vector<Territory*>& members = t->continent->territories;
+            auto it = std::find(members.begin(), members.end(), t);
+            if (it != members.end()) members.erase(it);
+        }
+        t->continent = continents[move.second];
+        t->continent->territories.push_back(t);
+        state.assignContinent(move.first, move.second);
+    }
+
+    // New territories take the ids after the current ones
+    std::vector<TerritorySeed> seeds;
+    int nextId = (int)topology->names.size();
+    for (const MapDiff::TerritoryEntry& entry : diff.addedTerritories) {
+        int continent = continentOf(entry.continent);
+        if (continent < 0 || idOf(entry.name) >= 0) continue;
+        seeds.push_back({nextId++, entry.name, continent, entry.x, entry.y});
+        affected.push_back(continent);
+    }
+    size_t firstAdded = territories.size();
+    addTerritories(seeds, false);
+    if (territories.size() * 2 > topology->nameSlots.size()) {
+        size_t capacity = std::max<size_t>(16, topology->nameSlots.size());
+        while (territories.size() * 2 > capacity) capacity *= 2;
+        rebuildNameIndex(capacity);
+    } else {
+        for (size_t i = firstAdded; i < territories.size(); i++) indexName(i);
+    }
+
+    std::vector<std::pair<int, int>> addedEdges;
+    for (const auto& edge : diff.addedEdges) {
+        int a = idOf(edge.first);
+        int b = idOf(edge.second);
+        if (a < 0 || b < 0) continue;
+        addedEdges.push_back({a, b});
+        adds.push_back({a, b});
+        adds.push_back({b, a});
+    }
+    spliceAdjacency(drops, adds);
+
+    // Links of the edges still around the moved territories, of the new territories' edges and of the added edges
+    relinked = addedEdges;
+    for (const TerritorySeed& seed : seeds) movedIds.push_back(seed.id);
+    for (int id : movedIds) {
+        for (int i = offsets[id]; i < offsets[id + 1]; i++) relinked.push_back({id, targets[i]});
+    }
+    normalizeEdges(relinked);
+    countLinks(relinked, 1);
+    topology->continentLinks = std::make_shared<const std::unordered_map<uint64_t, int>>(std::move(links));
+
+    MapValidationReport result;
+    if (!wasValid) {
+        validate(&result, true);
+    } else {
+        std::sort(affected.begin(), affected.end());
+        affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+        auto start = std::chrono::steady_clock::now();
+        const size_t words = (territoryTable.size() + 63) / 64;
+        std::vector<uint64_t> allowed(words, 0);
+        std::vector<uint64_t> visited(words, 0);
+        std::vector<int> frontier;
+        result.continentsConnected = true;
+        for (int c : affected) {
+            if (c < 0) continue;
+            const std::vector<Territory*>& members = continents[c]->getTerritories();
+            if (members.empty() || !isSubgraphConnected(members, allowed, visited, frontier)) {
+                result.continentsConnected = false;
+                break;
+            }
+        }
+        result.continentsMs = elapsedMs(start);
+
+        // With every continent connected, the map is connected exactly when the
+        // continents are, through the edges between them
+        start = std::chrono::steady_clock::now();
+        if (result.continentsConnected) {
+            std::vector<int> parent(continents.size());
+            std::vector<int> size(continents.size(), 1);
+            for (size_t c = 0; c < parent.size(); c++) parent[c] = (int)c;
+            int components = (int)continents.size();
+            for (const auto& link : *topology->continentLinks) {
+                if (unite(parent, size, (int)(link.first >> 32), (int)(uint32_t)link.first)) components--;
+            }
+            result.connected = components <= 1;
+        } else {
+            result.connected = isConnectedGraph();
+        }
+        result.connectedMs = elapsedMs(start);
+        // Moves take a territory out of its old continent, so membership stays unique
+        result.uniqueContinents = true;
+    }
+    loadReport = result;
+    hasLoadReport = true;
+    if (report) *report = result;
+    return result.isValid();
+}
+
+namespace {
+    // Breadth-first walk from start over territories not yet placed, returning the depth
+    // of the deepest level and leaving that level in lastLevel. seen holds the number of
+    // the walk that last reached each id, so walks do not need to clear it.
+    int walkDepth(const std::vector<int>& offsets, const std::vector<int>& targets, const std::vector<char>& placed,
+                  int start, int walk, std::vector<int>& seen, std::vector<int>& queue, std::vector<int>& lastLevel) {
+        queue.assign(1, start);
+        seen[start] = walk;
+        int depth = 0;
+        size_t levelBegin = 0;
+        while (levelBegin < queue.size()) {
+            size_t levelEnd = queue.size();
+            for (size_t head = levelBegin; head < levelEnd; head++) {
+                int cur = queue[head];
+                for (int i = offsets[cur]; i < offsets[cur + 1]; i++) {
+                    int n = targets[i];
+                    if (placed[n] || seen[n] == walk) continue;
+                    seen[n] = walk;
+                    queue.push_back(n);
+                }
+            }
+            if (queue.size() == levelEnd) {
+                lastLevel.assign(queue.begin() + levelBegin, queue.end());
+                return depth;
+            }
+            levelBegin = levelEnd;
+            depth++;
+        }
+        return depth;
+    }
+
+    // Old ids in their new order. Each connected part of the map starts from a
+    // pseudo-peripheral territory (George-Liu: walk again from a lowest-degree territory
+    // of the deepest level while that makes the walk deeper), so the levels are many and
+    // narrow. Cuthill-McKee visits each territory's neighbours by increasing degree;
+    // reversing the whole order then tends to narrow the profile further.
+    std::vector<int> traversalOrder(const std::vector<int>& offsets, const std::vector<int>& targets,
+                                    const std::vector<Territory*>& table, MapOrdering ordering) {
+        const int rows = (int)table.size();
+        const bool cuthillMcKee = ordering == MapOrdering::ReverseCuthillMcKee;
+        auto degree = [&](int id) { return offsets[id + 1] - offsets[id]; };
+        std::vector<char> placed(rows, 0);
+        std::vector<int> seen(rows, -1);
+        std::vector<int> queue;
+        std::vector<int> lastLevel;
+        std::vector<int> candidate;
+        std::vector<int> order;
+        order.reserve(rows);
+        int walk = 0;
+
+        for (int first = 0; first < rows; first++) {
+            if (!table[first] || placed[first]) continue;
+            int start = first;
+            int depth = walkDepth(offsets, targets, placed, start, walk++, seen, queue, lastLevel);
+            for (int round = 0; round < 4; round++) {
+                int next = *std::min_element(lastLevel.begin(), lastLevel.end(),
+                                             [&](int a, int b) { return degree(a) < degree(b); });
+                int nextDepth = walkDepth(offsets, targets, placed, next, walk++, seen, queue, candidate);
+                if (nextDepth <= depth) break;
+                start = next;
+                depth = nextDepth;
+                lastLevel.swap(candidate);
+            }
+
+            size_t head = order.size();
+            order.push_back(start);
+            placed[start] = 1;
+            for (; head < order.size(); head++) {
+                int cur = order[head];
+                size_t added = order.size();
+                for (int i = offsets[cur]; i < offsets[cur + 1]; i++) {
+                    int n = targets[i];
+                    if (placed[n]) continue;
+                    placed[n] = 1;
+                    order.push_back(n);
+                }
+                if (cuthillMcKee) {
+                    std::sort(order.begin() + added, order.end(), [&](int a, int b) {
+                        return degree(a) != degree(b) ? degree(a) < degree(b) : a < b;
+                    });
+                }
+            }
+        }
+        if (cuthillMcKee) std::reverse(order.begin(), order.end());
+        return order;
+    }
+}
+
+bool Map::renumber(MapOrdering ordering) {
+    ensureHandles();
+    if (ordering == MapOrdering::File || looseTerritories > 0 || !hasAdjacency()) return false;
+    std::vector<int> order = traversalOrder(topology->adjacencyOffsets, topology->adjacencyTargets, territoryTable, ordering);
+
+    // Ids no territory uses keep their relative order after the others
+    std::vector<int> newIds(territoryTable.size(), -1);
+    int next = 0;
+    for (int id : order) newIds[id] = next++;
+    for (int& id : newIds) {
+        if (id < 0) id = next++;
+    }
+    applyRenumbering(newIds);
     return true;
 }
 
-MapLoader::MapLoader() {}
+// Move every id-indexed table to newIds[id], a permutation of the ids. The checks made
+// while loading still describe the map, since its graph has not changed.
+void Map::applyRenumbering(const std::vector<int>& newIds) {
+    MapTopology& topo = editTopology();
+    const size_t rows = newIds.size();
+
+    std::vector<std::string_view> names(rows);
+    std::vector<int> coordinates(2 * rows);
+    std::vector<Territory*> table(rows, nullptr);
+    for (size_t id = 0; id < rows; id++) {
+        int to = newIds[id];
+        names[to] = topo.names[id];
+        coordinates[2 * to] = topo.coordinates[2 * id];
+        coordinates[2 * to + 1] = topo.coordinates[2 * id + 1];
+        table[to] = territoryTable[id];
+    }
+    topo.names.swap(names);
+    topo.coordinates.swap(coordinates);
+    territoryTable.swap(table);
+
+    // Rows move whole; their targets are renamed in place and keep their order
+    std::vector<int> offsets(rows + 1, 0);
+    std::vector<int> targets(topo.adjacencyTargets.size());
+    for (size_t id = 0; id < rows; id++) {
+        offsets[newIds[id] + 1] = topo.adjacencyOffsets[id + 1] - topo.adjacencyOffsets[id];
+    }
+    for (size_t r = 0; r < rows; r++) offsets[r + 1] += offsets[r];
+    for (size_t id = 0; id < rows; id++) {
+        int write = offsets[newIds[id]];
+        for (int i = topo.adjacencyOffsets[id]; i < topo.adjacencyOffsets[id + 1]; i++) {
+            targets[write++] = newIds[topo.adjacencyTargets[i]];
+        }
+    }
+    topo.adjacencyOffsets.swap(offsets);
+    topo.adjacencyTargets.swap(targets);
+
+    // Every territory is in the id table, so the table gives the new list order. Names
+    // hash to the same slots as before and only the positions they hold change.
+    state.renumber(newIds);
+    std::vector<int> newPosition(territories.size());
+    std::vector<int> rank(rows, -1);
+    int position = 0;
+    for (size_t id = 0; id < rows; id++) {
+        if (territoryTable[id]) rank[id] = position++;
+    }
+    for (size_t i = 0; i < territories.size(); i++) newPosition[i] = rank[newIds[topo.territoryIds[i]]];
+    for (int& entry : topo.nameSlots) {
+        if (entry >= 0) entry = newPosition[entry];
+    }
+
+    for (Continent* c : continents) c->territories.clear();
+    territories.clear();
+    topo.territoryIds.clear();
+    for (size_t id = 0; id < rows; id++) {
+        Territory* t = territoryTable[id];
+        if (!t) continue;
+        t->id = (int)id;
+        territories.push_back(t);
+        topo.territoryIds.push_back((int)id);
+        if (t->continent) t->continent->territories.push_back(t);
+    }
+}
+
+MapLoader::MapLoader() : mode(MapLoadMode::Stream), ordering(MapOrdering::File), quiet(false) {}
+
+MapLoader::MapLoader(MapLoadMode mode) : mode(mode), ordering(MapOrdering::File), quiet(false) {}
+
+MapLoadMode MapLoader::getMode() const { return mode; }
+void MapLoader::setMode(MapLoadMode m) { mode = m; }
+MapOrdering MapLoader::getOrdering() const { return ordering; }
+void MapLoader::setOrdering(MapOrdering o) { ordering = o; }
+bool MapLoader::isQuiet() const { return quiet; }
+void MapLoader::setQuiet(bool q) { quiet = q; }
+const std::string& MapLoader::getLastError() const { return lastError; }
+
+namespace {
+    bool hasExtension(const std::string& filename, const std::string& extension) {
+        return filename.size() >= extension.size() &&
+               filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+    }
+}
 
 Map* MapLoader::loadMap(const std::string& filename) {
-    Map* map = parseFile(filename);
-    if (map && map->validate()) {
-        return map;
+    return loadMap(filename, nullptr);
+}
+
+Map* MapLoader::loadMap(const std::string& filename, MapLoadResult* result) {
+    lastError.clear();
+    auto start = std::chrono::steady_clock::now();
+    Map* map = nullptr;
+    MapValidationReport report;
+    bool valid = false;
+
+    if (hasExtension(filename, ".wzmap")) {
+        // Compiled maps were validated when they were written
+        map = loadCompiledFile(filename);
+        valid = map && map->validate(&report);
     } else {
-        std::cout << "Invalid map file: " << filename << std::endl;
+        // The parsers validate as they read, so this returns their result without another pass
+        map = (mode == MapLoadMode::Mapped) ? parseMappedFile(filename) : parseFile(filename);
+        valid = map && map->validate(&report);
+        if (map && !valid) reportInvalid(report);
+    }
+    if (valid) map->renumber(ordering);
+
+    if (result) {
+        double totalMs = elapsedMs(start);
+        result->file = filename;
+        result->valid = valid;
+        result->reason = valid ? std::string() : lastError;
+        result->territories = map ? (int)map->getTerritories().size() : 0;
+        result->continents = map ? (int)map->getContinents().size() : 0;
+        result->validateMs = report.connectedMs + report.continentsMs + report.uniqueContinentsMs;
+        result->parseMs = std::max(0.0, totalMs - result->validateMs);
+    }
+
+    if (!valid) {
+        if (!quiet) std::cout << "Invalid map file: " << filename << std::endl;
         delete map;
         return nullptr;
     }
+    return map;
+}
+
+void MapLoader::reportInvalid(const MapValidationReport& report) {
+    if (!report.connected) reportError("Error: Map is not a connected graph");
+    else if (!report.continentsConnected) reportError("Error: A continent is empty or not connected");
+    else reportError("Error: A territory belongs to more than one continent");
+}
+
+std::vector<MapLoadResult> MapLoader::loadBatch(const std::vector<std::string>& files) const {
+    std::vector<MapLoadResult> results(files.size());
+    ThreadPool::shared().parallelFor(files.size(), [&](size_t i) {
+        MapLoader loader(mode);
+        loader.setOrdering(ordering);
+        loader.setQuiet(true);
+        delete loader.loadMap(files[i], &results[i]);
+    });
+    return results;
+}
+
+std::vector<std::string> MapLoader::listMapFiles(const std::string& directory) {
+    std::vector<std::string> files;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (!entry.is_regular_file(error)) continue;
+        std::string path = entry.path().string();
+        if (hasExtension(path, ".map") || hasExtension(path, ".wzmap")) files.push_back(path);
+    }
+    std::sort(files.begin(), files.end());
+    return files;
 }
 
 std::string trim(const std::string& str) {
@@ -215,18 +1591,77 @@ std::vector<std::string> split(const std::string& str, char delimiter) {
     return tokens;
 }
 
+namespace {
+    // Map validation fused into parsing: territories and edges are fed in as they are
+    // read, and two union-finds (all edges, and edges inside one continent) count the
+    // connected components, so no pass over the finished graph is needed. Every
+    // territory line names exactly one continent, so that check holds by construction.
+    class StreamingCheck {
+    public:
+        StreamingCheck() : components(0) {}
+
+        void addContinent() { continentComponents.push_back(0); }
+
+        // Territory ids are assigned densely in file order
+        void addTerritory(int continent) {
+            int id = (int)continentOf.size();
+            parent.push_back(id);
+            size.push_back(1);
+            localParent.push_back(id);
+            localSize.push_back(1);
+            continentOf.push_back(continent);
+            components++;
+            continentComponents[continent]++;
+        }
+
+        void addEdge(int a, int b) {
+            if (unite(parent, size, a, b)) components--;
+            if (continentOf[a] == continentOf[b] && unite(localParent, localSize, a, b)) {
+                continentComponents[continentOf[a]]--;
+            }
+        }
+
+        // Empty continents fail, as in Map::continentsAreConnected
+        MapValidationReport report(double ms) const {
+            MapValidationReport result;
+            result.connected = components <= 1;
+            result.continentsConnected = std::all_of(continentComponents.begin(), continentComponents.end(),
+                                                     [](int count) { return count == 1; });
+            result.uniqueContinents = true;
+            result.connectedMs = ms;
+            return result;
+        }
+
+    private:
+        std::vector<int> parent, size;
+        std::vector<int> localParent, localSize;
+        std::vector<int> continentOf;
+        std::vector<int> continentComponents;
+        int components;
+    };
+}
+
 Map* MapLoader::parseFile(const std::string& filename) {
     std::ifstream file(filename);
-    if (!file.is_open()) return nullptr;
+    if (!file.is_open()) {
+        reportError("Error: Could not open map file: ", filename);
+        return nullptr;
+    }
 
     Map* map = new Map();
     std::string line;
     bool inContinents = false;
     bool inTerritories = false;
 
-    std::unordered_map<std::string, Continent*> continentMap;
-    std::unordered_map<std::string, Territory*> territoryMap;
-    std::vector<std::pair<std::string, std::vector<std::string>>> adjacencyData;
+    std::unordered_map<std::string, int> continentMap;      // name -> continent index
+    std::vector<std::pair<int, std::vector<std::string>>> adjacencyData;
+    StreamingCheck check;
+
+    // Territories are created together once the file is read, so the map can lay
+    // them out by continent; the deque keeps the names in place for the seeds' views
+    std::deque<std::string> territoryNames;
+    std::unordered_set<std::string_view> seenTerritories;
+    std::vector<Map::TerritorySeed> seeds;
 
     while (std::getline(file, line)) {
         line = trim(line);
@@ -245,7 +1680,7 @@ Map* MapLoader::parseFile(const std::string& filename) {
         if (inContinents) {
             size_t pos = line.find('=');
             if (pos == std::string::npos || pos == line.length() - 1) {
-                std::cout << "Error: Invalid continent line: " << line << std::endl;
+                reportError("Error: Invalid continent line: ", line);
                 delete map;
                 return nullptr;
             }
@@ -253,13 +1688,19 @@ Map* MapLoader::parseFile(const std::string& filename) {
             std::string name = trim(line.substr(0, pos));
             std::string bonusStr = trim(line.substr(pos + 1));
             
+            if (continentMap.count(name)) {
+                reportError("Error: Duplicate continent: ", name);
+                delete map;
+                return nullptr;
+            }
+
             try {
-                std::stoi(bonusStr); // Validate bonus is numeric
-                Continent* c = new Continent(name);
-                map->addContinent(c);
-                continentMap[name] = c;
+                Continent* c = map->arena.create<Continent>(std::string(), std::stoi(bonusStr));
+                continentMap[name] = (int)map->getContinents().size();
+                map->registerContinent(c, name);
+                check.addContinent();
             } catch (const std::exception&) {
-                std::cout << "Error: Invalid bonus value in continent line: " << line << std::endl;
+                reportError("Error: Invalid bonus value in continent line: ", line);
                 delete map;
                 return nullptr;
             }
@@ -268,7 +1709,7 @@ Map* MapLoader::parseFile(const std::string& filename) {
         if (inTerritories) {
             std::vector<std::string> tokens = split(line, ',');
             if (tokens.size() < 4) {
-                std::cout << "Error: Invalid territory line: " << line << std::endl;
+                reportError("Error: Invalid territory line: ", line);
                 delete map;
                 return nullptr;
             }
@@ -276,52 +1717,728 @@ Map* MapLoader::parseFile(const std::string& filename) {
             std::string name = tokens[0];
             std::string continentName = tokens[3];
             
-            // Validate coordinates are numeric (but don't store them as they're unused)
+            int x = 0;
+            int y = 0;
             try {
-                std::stoi(tokens[1]); // x coordinate
-                std::stoi(tokens[2]); // y coordinate
+                x = std::stoi(tokens[1]);
+                y = std::stoi(tokens[2]);
             } catch (const std::exception&) {
-                std::cout << "Error: Invalid coordinates in line: " << line << std::endl;
+                reportError("Error: Invalid coordinates in line: ", line);
                 delete map;
                 return nullptr;
             }
             
-            if (continentMap.find(continentName) == continentMap.end()) {
-                std::cout << "Error: Continent not found for territory " << name << std::endl;
+            auto cit = continentMap.find(continentName);
+            if (cit == continentMap.end()) {
+                reportError("Error: Continent not found for territory ", name);
+                delete map;
+                return nullptr;
+            }
+            if (seenTerritories.count(name)) {
+                reportError("Error: Duplicate territory: ", name);
                 delete map;
                 return nullptr;
             }
 
-            Territory* t = new Territory((int)map->getTerritories().size(), name, continentMap[continentName]);
-            continentMap[continentName]->addTerritory(t);
-            map->addTerritory(t);
-            territoryMap[name] = t;
+            int id = (int)seeds.size();
+            territoryNames.push_back(name);
+            seenTerritories.insert(territoryNames.back());
+            seeds.push_back({id, territoryNames.back(), cit->second, x, y});
+            check.addTerritory(cit->second);
             
             // Store adjacency data for later processing
             if (tokens.size() > 4) {
                 std::vector<std::string> adjacents(tokens.begin() + 4, tokens.end());
-                adjacencyData.push_back({name, adjacents});
+                adjacencyData.push_back({id, adjacents});
             }
         }
     }
     
-    // Process adjacencies in a single pass
+    map->addTerritories(seeds, true);
+
+    // Process adjacencies in a single pass, checking connectivity as the edges arrive,
+    // then freeze them into the map's CSR table
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::pair<int, int>> edges;
     for (const auto& adj : adjacencyData) {
-        Territory* territory = territoryMap[adj.first];
-        if (!territory) continue;
-        
         for (const std::string& adjacentName : adj.second) {
-            auto it = territoryMap.find(adjacentName);
-            if (it != territoryMap.end()) {
-                territory->addAdjacentTerritory(it->second);
-                it->second->addAdjacentTerritory(territory); // Make bidirectional
+            Territory* adjacent = map->getTerritoryByName(adjacentName);
+            if (!adjacent) {
+                reportError("Error: Unknown adjacent territory ", adjacentName, " for territory ",
+                            map->getTerritory(adj.first)->getName());
+                delete map;
+                return nullptr;
             }
+            edges.push_back({adj.first, adjacent->getId()}); // Undirected
+            check.addEdge(adj.first, adjacent->getId());
         }
     }
+    MapValidationReport report = check.report(elapsedMs(start));
+    map->buildAdjacency(edges);
+    map->loadReport = report;
+    map->hasLoadReport = true;
     
     return map;
 }
 
+namespace {
+    // Read-only view of a whole file. Uses mmap where available and falls back
+    // to reading the file into a buffer elsewhere, so callers only see a string_view.
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& filename) : data(nullptr), size(0), open(false) {
+#ifndef _WIN32
+            int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd < 0) return;
+            struct stat st;
+            if (fstat(fd, &st) == 0) {
+                size = static_cast<size_t>(st.st_size);
+                if (size == 0) {
+                    open = true;
+                } else {
+                    void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (p != MAP_FAILED) {
+                        data = static_cast<const char*>(p);
+                        open = true;
+                    }
+                }
+            }
+            ::close(fd);
+#else
+            std::ifstream file(filename, std::ios::binary);
+            if (!file.is_open()) return;
+            std::ostringstream ss;
+            ss << file.rdbuf();
+            buffer = ss.str();
+            data = buffer.data();
+            size = buffer.size();
+            open = true;
+#endif
+        }
+
+        ~MappedFile() {
+#ifndef _WIN32
+            if (data) munmap(const_cast<char*>(data), size);
+#endif
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool isOpen() const { return open; }
+        std::string_view view() const { return std::string_view(data, data ? size : 0); }
+
+    private:
+        const char* data;
+        size_t size;
+        bool open;
+#ifdef _WIN32
+        std::string buffer;
+#endif
+    };
+
+    std::string_view trimView(std::string_view str) {
+        size_t start = str.find_first_not_of(" \t\r\n");
+        if (start == std::string_view::npos) return std::string_view();
+        size_t end = str.find_last_not_of(" \t\r\n");
+        return str.substr(start, end - start + 1);
+    }
+
+    // Same acceptance rules as std::stoi: optional sign, at least one digit, trailing text ignored.
+    // from_chars takes no '+', so one is dropped only in front of a digit; "+-5" stays invalid
+    bool parseIntView(std::string_view str, int& out) {
+        if (str.size() > 1 && str[0] == '+' && str[1] >= '0' && str[1] <= '9') str.remove_prefix(1);
+        auto result = std::from_chars(str.data(), str.data() + str.size(), out);
+        return result.ec == std::errc();
+    }
+
+    // Split on a delimiter without allocating; empty (after trim) fields are dropped like split()
+    void splitView(std::string_view str, char delimiter, std::vector<std::string_view>& tokens) {
+        tokens.clear();
+        size_t start = 0;
+        while (start <= str.size()) {
+            size_t end = str.find(delimiter, start);
+            if (end == std::string_view::npos) end = str.size();
+            std::string_view token = trimView(str.substr(start, end - start));
+            if (!token.empty()) tokens.push_back(token);
+            start = end + 1;
+        }
+    }
+}
+
+// Zero-copy variant of parseFile: tokenizes the mapped buffer with string_views and
+// only copies territory names once, into the map's own storage
+Map* MapLoader::parseMappedFile(const std::string& filename) {
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        reportError("Error: Could not open map file: ", filename);
+        return nullptr;
+    }
+
+    Map* map = new Map();
+    std::string_view text = file.view();
+    bool inContinents = false;
+    bool inTerritories = false;
+
+    std::unordered_map<std::string_view, int> continentMap;     // name -> continent index
+    StreamingCheck check;
+    std::unordered_set<std::string_view> seenTerritories;
+    std::vector<Map::TerritorySeed> seeds;
+
+    // Adjacency names are kept as views into the mapped file and resolved once all territories exist
+    struct PendingAdjacency {
+        int id;
+        size_t first;
+        size_t last;
+    };
+    std::vector<PendingAdjacency> adjacencyData;
+    std::vector<std::string_view> adjacencyNames;
+    std::vector<std::string_view> tokens;
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string_view::npos) eol = text.size();
+        std::string_view line = trimView(text.substr(pos, eol - pos));
+        pos = eol + 1;
+        if (line.empty()) continue;
+
+        if (line == "[Continents]") {
+            inContinents = true;
+            inTerritories = false;
+            continue;
+        } else if (line == "[Territories]") {
+            inContinents = false;
+            inTerritories = true;
+            continue;
+        }
+
+        if (inContinents) {
+            size_t eq = line.find('=');
+            if (eq == std::string_view::npos || eq == line.length() - 1) {
+                reportError("Error: Invalid continent line: ", line);
+                delete map;
+                return nullptr;
+            }
+
+            std::string_view name = trimView(line.substr(0, eq));
+            int bonus = 0;
+            if (!parseIntView(trimView(line.substr(eq + 1)), bonus)) {
+                reportError("Error: Invalid bonus value in continent line: ", line);
+                delete map;
+                return nullptr;
+            }
+
+            if (continentMap.count(name)) {
+                reportError("Error: Duplicate continent: ", name);
+                delete map;
+                return nullptr;
+            }
+
+            Continent* c = map->arena.create<Continent>(std::string(), bonus);
+            continentMap[name] = (int)map->getContinents().size();
+            map->registerContinent(c, name);
+            check.addContinent();
+        }
+
+        if (inTerritories) {
+            splitView(line, ',', tokens);
+            if (tokens.size() < 4) {
+                reportError("Error: Invalid territory line: ", line);
+                delete map;
+                return nullptr;
+            }
+
+            std::string_view name = tokens[0];
+            std::string_view continentName = tokens[3];
+
+            int x = 0;
+            int y = 0;
+            if (!parseIntView(tokens[1], x) || !parseIntView(tokens[2], y)) {
+                reportError("Error: Invalid coordinates in line: ", line);
+                delete map;
+                return nullptr;
+            }
+
+            auto cit = continentMap.find(continentName);
+            if (cit == continentMap.end()) {
+                reportError("Error: Continent not found for territory ", name);
+                delete map;
+                return nullptr;
+            }
+
+            if (!seenTerritories.insert(name).second) {
+                reportError("Error: Duplicate territory: ", name);
+                delete map;
+                return nullptr;
+            }
+
+            int id = (int)seeds.size();
+            seeds.push_back({id, name, cit->second, x, y});
+            check.addTerritory(cit->second);
+
+            if (tokens.size() > 4) {
+                size_t first = adjacencyNames.size();
+                adjacencyNames.insert(adjacencyNames.end(), tokens.begin() + 4, tokens.end());
+                adjacencyData.push_back({id, first, adjacencyNames.size()});
+            }
+        }
+    }
+
+    map->addTerritories(seeds, true);
+
+    // Process adjacencies in a single pass, checking connectivity as the edges arrive,
+    // then freeze them into the map's CSR table
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(adjacencyNames.size());
+    for (const PendingAdjacency& adj : adjacencyData) {
+        for (size_t i = adj.first; i < adj.last; ++i) {
+            Territory* adjacent = map->getTerritoryByName(adjacencyNames[i]);
+            if (!adjacent) {
+                reportError("Error: Unknown adjacent territory ", adjacencyNames[i], " for territory ",
+                            map->getTerritory(adj.id)->getName());
+                delete map;
+                return nullptr;
+            }
+            edges.push_back({adj.id, adjacent->getId()}); // Undirected
+            check.addEdge(adj.id, adjacent->getId());
+        }
+    }
+    MapValidationReport report = check.report(elapsedMs(start));
+    map->buildAdjacency(edges);
+    map->loadReport = report;
+    map->hasLoadReport = true;
+
+    return map;
+}
+
+// Reads the file the way parseMappedFile does, without building a map, and compares
+// it with the loaded map by name. Territories are keyed by their id in the loaded map,
+// new ones by numbers past those ids, so both edge sets can be compared as sorted pairs.
+// Names are resolved through the map's own name index; only new names need a table here
+bool MapLoader::diff(const Map& map, const std::string& filename, MapDiff& result) {
+    lastError.clear();
+    result = MapDiff();
+    if (hasExtension(filename, ".wzmap")) {
+        reportError("Error: Only text maps can be compared: ", filename);
+        return false;
+    }
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        reportError("Error: Could not open map file: ", filename);
+        return false;
+    }
+
+    struct TerritoryLine {
+        std::string_view name;
+        std::string_view continent;
+        int x;
+        int y;
+        size_t first;       // adjacency names [first, last)
+        size_t last;
+    };
+    std::vector<std::pair<std::string_view, int>> continentLines;
+    std::unordered_set<std::string_view> continentNames;
+    std::vector<TerritoryLine> territoryLines;
+    std::vector<std::string_view> adjacencyNames;
+    std::vector<std::string_view> tokens;
+
+    std::string_view text = file.view();
+    bool inContinents = false;
+    bool inTerritories = false;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string_view::npos) eol = text.size();
+        std::string_view line = trimView(text.substr(pos, eol - pos));
+        pos = eol + 1;
+        if (line.empty()) continue;
+
+        if (line == "[Continents]") {
+            inContinents = true;
+            inTerritories = false;
+            continue;
+        } else if (line == "[Territories]") {
+            inContinents = false;
+            inTerritories = true;
+            continue;
+        }
+
+        if (inContinents) {
+            size_t eq = line.find('=');
+            if (eq == std::string_view::npos || eq == line.length() - 1) {
+                reportError("Error: Invalid continent line: ", line);
+                return false;
+            }
+            std::string_view name = trimView(line.substr(0, eq));
+            int bonus = 0;
+            if (!parseIntView(trimView(line.substr(eq + 1)), bonus)) {
+                reportError("Error: Invalid bonus value in continent line: ", line);
+                return false;
+            }
+            if (!continentNames.insert(name).second) {
+                reportError("Error: Duplicate continent: ", name);
+                return false;
+            }
+            continentLines.push_back({name, bonus});
+        }
+
+        if (inTerritories) {
+            splitView(line, ',', tokens);
+            if (tokens.size() < 4) {
+                reportError("Error: Invalid territory line: ", line);
+                return false;
+            }
+            TerritoryLine entry{tokens[0], tokens[3], 0, 0, adjacencyNames.size(), 0};
+            if (!parseIntView(tokens[1], entry.x) || !parseIntView(tokens[2], entry.y)) {
+                reportError("Error: Invalid coordinates in line: ", line);
+                return false;
+            }
+            if (!continentNames.count(entry.continent)) {
+                reportError("Error: Continent not found for territory ", entry.name);
+                return false;
+            }
+            adjacencyNames.insert(adjacencyNames.end(), tokens.begin() + 4, tokens.end());
+            entry.last = adjacencyNames.size();
+            territoryLines.push_back(entry);
+        }
+    }
+
+    std::unordered_map<std::string_view, const Continent*> oldContinents;
+    for (const Continent* c : map.getContinents()) oldContinents[c->getName()] = c;
+    for (const auto& line : continentLines) {
+        auto it = oldContinents.find(line.first);
+        if (it == oldContinents.end()) {
+            result.addedContinents.push_back({std::string(line.first), line.second});
+        } else if (it->second->getBonus() != line.second) {
+            result.changedBonuses.push_back({std::string(line.first), line.second});
+        }
+    }
+    for (const Continent* c : map.getContinents()) {
+        if (!continentNames.count(c->getName())) result.removedContinents.push_back(std::string(c->getName()));
+    }
+
+    const int idCount = (int)map.topology->names.size();
+    std::vector<int> keyOf(territoryLines.size());
+    std::vector<std::string_view> addedNames;
+    std::unordered_map<std::string_view, int> addedKeys;
+    std::vector<char> kept(idCount, 0);
+    for (size_t i = 0; i < territoryLines.size(); i++) {
+        const TerritoryLine& line = territoryLines[i];
+        Territory* t = map.getTerritoryByName(line.name);
+        bool duplicate = t && t->getId() >= 0 ? kept[t->getId()] != 0
+                                              : !addedKeys.emplace(line.name, idCount + (int)addedNames.size()).second;
+        if (duplicate) {
+            reportError("Error: Duplicate territory: ", line.name);
+            return false;
+        }
+        if (!t || t->getId() < 0) {
+            keyOf[i] = idCount + (int)addedNames.size();
+            addedNames.push_back(line.name);
+            result.addedTerritories.push_back({std::string(line.name), std::string(line.continent), line.x, line.y});
+            continue;
+        }
+        keyOf[i] = t->getId();
+        kept[t->getId()] = 1;
+        std::string_view continent = t->getContinent() ? t->getContinent()->getName() : std::string_view();
+        if (continent != line.continent || t->getX() != line.x || t->getY() != line.y) {
+            result.changedTerritories.push_back({std::string(line.name), std::string(line.continent), line.x, line.y});
+        }
+    }
+    for (Territory* t : map.getTerritories()) {
+        if (t->getId() >= 0 && !kept[t->getId()]) result.removedTerritories.push_back(std::string(t->getName()));
+    }
+
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(adjacencyNames.size());
+    for (size_t i = 0; i < territoryLines.size(); i++) {
+        const TerritoryLine& line = territoryLines[i];
+        for (size_t j = line.first; j < line.last; j++) {
+            Territory* t = map.getTerritoryByName(adjacencyNames[j]);
+            int key = t && t->getId() >= 0 && kept[t->getId()] ? t->getId() : -1;
+            if (key < 0) {
+                auto it = addedKeys.find(adjacencyNames[j]);
+                if (it == addedKeys.end()) {
+                    reportError("Error: Unknown adjacent territory ", adjacencyNames[j], " for territory ", line.name);
+                    return false;
+                }
+                key = it->second;
+            }
+            edges.push_back({keyOf[i], key});
+        }
+    }
+    normalizeEdges(edges);
+
+    std::vector<std::pair<int, int>> oldEdges;
+    if (map.hasAdjacency()) {
+        const std::vector<int>& offsets = map.getAdjacencyOffsets();
+        const std::vector<int>& targets = map.getAdjacencyTargets();
+        for (int a = 0; a < idCount; a++) {
+            if (!kept[a]) continue;
+            for (int i = offsets[a]; i < offsets[a + 1]; i++) {
+                if (targets[i] >= a && kept[targets[i]]) oldEdges.push_back({a, targets[i]});
+            }
+        }
+        std::sort(oldEdges.begin(), oldEdges.end());     // rows are in file order, not sorted
+    }
+    auto nameOf = [&](int key) {
+        return std::string(key < idCount ? map.getTerritory(key)->getName() : addedNames[key - idCount]);
+    };
+    std::vector<std::pair<int, int>> changed;
+    std::set_difference(edges.begin(), edges.end(), oldEdges.begin(), oldEdges.end(), std::back_inserter(changed));
+    for (const auto& e : changed) result.addedEdges.push_back({nameOf(e.first), nameOf(e.second)});
+    changed.clear();
+    std::set_difference(oldEdges.begin(), oldEdges.end(), edges.begin(), edges.end(), std::back_inserter(changed));
+    for (const auto& e : changed) result.removedEdges.push_back({nameOf(e.first), nameOf(e.second)});
+    return true;
+}
+
+bool MapLoader::reload(Map& map, const std::string& filename, MapDiff* applied) {
+    MapDiff changes;
+    if (!diff(map, filename, changes)) return false;
+
+    MapValidationReport report;
+    bool valid;
+    if (changes.removedContinents.empty()) {
+        valid = map.applyDiff(changes, &report);
+    } else {
+        // Continent indices are never renumbered in place
+        Map* fresh = (mode == MapLoadMode::Mapped) ? parseMappedFile(filename) : parseFile(filename);
+        if (!fresh) return false;
+        map = *fresh;
+        delete fresh;
+        valid = map.validate(&report);
+    }
+    if (!valid) reportInvalid(report);
+    if (applied) *applied = std::move(changes);
+    return valid;
+}
+
+namespace {
+    // Compiled .wzmap layout (native byte order, every field 4 bytes):
+    //   CompiledHeader
+    //   CompiledContinent[continentCount]
+    //   CompiledTerritory[territoryCount]       in Map::getTerritories() order
+    //   int32 adjacencyOffsets[idCount + 1]     the CSR table, indexed by territory id
+    //   int32 adjacencyTargets[edgeCount]
+    //   int32 nameSlots[nameSlotCount]          the name index, ready to use
+    //   char  strings[stringBytes]              all names back to back
+    const uint32_t kCompiledMagic = 0x504D5A57;    // "WZMP"
+    const uint32_t kCompiledByteOrder = 0x01020304;
+    const uint32_t kCompiledVersion = 2;
+
+    struct CompiledHeader {
+        uint32_t magic;
+        uint32_t byteOrder;
+        uint32_t version;
+        int32_t continentCount;
+        int32_t territoryCount;
+        int32_t idCount;
+        int32_t edgeCount;
+        int32_t nameSlotCount;
+        int32_t stringBytes;
+    };
+
+    struct CompiledContinent {
+        int32_t nameOffset;
+        int32_t nameLength;
+        int32_t bonus;
+    };
+
+    struct CompiledTerritory {
+        int32_t id;
+        int32_t nameOffset;
+        int32_t nameLength;
+        int32_t continent;
+        int32_t x;
+        int32_t y;
+    };
+
+    // Bounds-checked sequential reader over the mapped file
+    class CompiledReader {
+    public:
+        explicit CompiledReader(std::string_view data) : data(data), pos(0) {}
+
+        template <typename T>
+        bool read(T* out, size_t count) {
+            size_t bytes = sizeof(T) * count;
+            if (count > data.size() / sizeof(T) || bytes > data.size() - pos) return false;
+            if (bytes > 0) std::memcpy(out, data.data() + pos, bytes);
+            pos += bytes;
+            return true;
+        }
+
+        bool skip(size_t bytes, std::string_view& out) {
+            if (bytes > data.size() - pos) return false;
+            out = data.substr(pos, bytes);
+            pos += bytes;
+            return true;
+        }
+
+        bool atEnd() const { return pos == data.size(); }
+
+    private:
+        std::string_view data;
+        size_t pos;
+    };
+
+    bool nameInRange(int32_t offset, int32_t length, std::string_view strings) {
+        return offset >= 0 && length >= 0 && (size_t)offset <= strings.size() &&
+               (size_t)length <= strings.size() - offset;
+    }
+}
+
+bool MapLoader::compile(const std::string& textFile, const std::string& compiledFile) {
+    Map* map = loadMap(textFile);
+    if (!map) return false;
+
+    const std::vector<Continent*>& continents = map->getContinents();
+    const std::vector<Territory*>& territories = map->getTerritories();
+    std::string strings;
+
+    std::vector<CompiledContinent> continentRecords;
+    continentRecords.reserve(continents.size());
+    for (Continent* c : continents) {
+        continentRecords.push_back({(int32_t)strings.size(), (int32_t)c->getName().size(), c->bonus});
+        strings += c->getName();
+    }
+
+    std::vector<CompiledTerritory> territoryRecords;
+    territoryRecords.reserve(territories.size());
+    for (Territory* t : territories) {
+        territoryRecords.push_back({t->getId(), (int32_t)strings.size(), (int32_t)t->getName().size(),
+                                    map->getContinentIndex(t->getContinent()), t->getX(), t->getY()});
+        strings += t->getName();
+    }
+
+    CompiledHeader header = {kCompiledMagic, kCompiledByteOrder, kCompiledVersion,
+                             (int32_t)continentRecords.size(), (int32_t)territoryRecords.size(),
+                             (int32_t)map->territoryTable.size(), (int32_t)map->topology->adjacencyTargets.size(),
+                             (int32_t)map->topology->nameSlots.size(), (int32_t)strings.size()};
+
+    std::ofstream out(compiledFile, std::ios::binary | std::ios::trunc);
+    auto write = [&](const void* data, size_t bytes) {
+        if (bytes > 0) out.write(static_cast<const char*>(data), bytes);
+    };
+    write(&header, sizeof(header));
+    write(continentRecords.data(), continentRecords.size() * sizeof(CompiledContinent));
+    write(territoryRecords.data(), territoryRecords.size() * sizeof(CompiledTerritory));
+    write(map->topology->adjacencyOffsets.data(), map->topology->adjacencyOffsets.size() * sizeof(int));
+    write(map->topology->adjacencyTargets.data(), map->topology->adjacencyTargets.size() * sizeof(int));
+    write(map->topology->nameSlots.data(), map->topology->nameSlots.size() * sizeof(int));
+    write(strings.data(), strings.size());
+    out.close();
+    delete map;
+
+    if (!out) {
+        reportError("Error: Could not write compiled map: ", compiledFile);
+        return false;
+    }
+    return true;
+}
+
+// Rebuilds a Map from a .wzmap file: continents and territories are carved from the
+// map's arena and the CSR table and name index are copied straight in
+Map* MapLoader::loadCompiledFile(const std::string& filename) {
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        reportError("Error: Could not open map file: ", filename);
+        return nullptr;
+    }
+
+    CompiledReader reader(file.view());
+    CompiledHeader header;
+    if (!reader.read(&header, 1) || header.magic != kCompiledMagic) {
+        reportError("Error: Not a compiled map: ", filename);
+        return nullptr;
+    }
+    if (header.byteOrder != kCompiledByteOrder || header.version != kCompiledVersion) {
+        reportError("Error: Unsupported compiled map version or byte order: ", filename);
+        return nullptr;
+    }
+
+    auto corrupt = [&](Map* map) -> Map* {
+        reportError("Error: Corrupt compiled map: ", filename);
+        delete map;
+        return nullptr;
+    };
+
+    if (header.continentCount < 0 || header.territoryCount < 0 || header.idCount < 0 || header.edgeCount < 0 ||
+        header.nameSlotCount < 0 || header.stringBytes < 0) {
+        return corrupt(nullptr);
+    }
+    // Check the counts against the file size before allocating anything
+    uint64_t expected = sizeof(CompiledHeader) + (uint64_t)header.continentCount * sizeof(CompiledContinent) +
+                        (uint64_t)header.territoryCount * sizeof(CompiledTerritory) +
+                        ((uint64_t)header.idCount + 1 + header.edgeCount + header.nameSlotCount) * sizeof(int32_t) +
+                        (uint64_t)header.stringBytes;
+    if (expected != file.view().size()) return corrupt(nullptr);
+
+    std::vector<CompiledContinent> continentRecords(header.continentCount);
+    std::vector<CompiledTerritory> territoryRecords(header.territoryCount);
+    Map* map = new Map();
+    std::string_view strings;
+    if (!reader.read(continentRecords.data(), continentRecords.size()) ||
+        !reader.read(territoryRecords.data(), territoryRecords.size())) {
+        return corrupt(map);
+    }
+    map->topology->adjacencyOffsets.resize((size_t)header.idCount + 1);
+    map->topology->adjacencyTargets.resize(header.edgeCount);
+    map->topology->nameSlots.resize(header.nameSlotCount);
+    if (!reader.read(map->topology->adjacencyOffsets.data(), map->topology->adjacencyOffsets.size()) ||
+        !reader.read(map->topology->adjacencyTargets.data(), map->topology->adjacencyTargets.size()) ||
+        !reader.read(map->topology->nameSlots.data(), map->topology->nameSlots.size()) ||
+        !reader.skip(header.stringBytes, strings) || !reader.atEnd()) {
+        return corrupt(map);
+    }
+
+    for (const CompiledContinent& rec : continentRecords) {
+        if (!nameInRange(rec.nameOffset, rec.nameLength, strings)) return corrupt(map);
+        map->registerContinent(map->arena.create<Continent>(std::string(), rec.bonus),
+                               strings.substr(rec.nameOffset, rec.nameLength));
+    }
+
+    std::vector<char> seenIds(header.idCount, 0);
+    std::vector<Map::TerritorySeed> seeds;
+    seeds.reserve(territoryRecords.size());
+    for (const CompiledTerritory& rec : territoryRecords) {
+        if (!nameInRange(rec.nameOffset, rec.nameLength, strings) || rec.id < 0 || rec.id >= header.idCount ||
+            seenIds[rec.id] || rec.continent < -1 || rec.continent >= header.continentCount) {
+            return corrupt(map);
+        }
+        seenIds[rec.id] = 1;
+        seeds.push_back({rec.id, strings.substr(rec.nameOffset, rec.nameLength), rec.continent, rec.x, rec.y});
+    }
+    map->addTerritories(seeds, false);
+    if ((int32_t)map->territoryTable.size() != header.idCount) return corrupt(map);
+
+    // The CSR rows must be well formed and only name territories that exist
+    const std::vector<int>& offsets = map->topology->adjacencyOffsets;
+    if (offsets.front() != 0 || offsets.back() != header.edgeCount) return corrupt(map);
+    for (size_t i = 1; i < offsets.size(); i++) {
+        if (offsets[i] < offsets[i - 1]) return corrupt(map);
+    }
+    for (int target : map->topology->adjacencyTargets) {
+        if (!map->getTerritory(target)) return corrupt(map);
+    }
+
+    // Name index: power-of-two capacity, at most half full, entries inside the territory list
+    size_t slots = map->topology->nameSlots.size();
+    if (slots == 0 ? header.territoryCount != 0 : (slots & (slots - 1)) != 0) return corrupt(map);
+    size_t used = 0;
+    for (int entry : map->topology->nameSlots) {
+        if (entry < -1 || entry >= header.territoryCount) return corrupt(map);
+        if (entry >= 0) used++;
+    }
+    if (used * 2 > slots) return corrupt(map);
+
+    // compile() only writes maps that passed validation
+    map->loadReport.connected = map->loadReport.continentsConnected = map->loadReport.uniqueContinents = true;
+    map->hasLoadReport = true;
+    return map;
+}
+
 // Stream insertion operators
 std::ostream& operator<<(std::ostream& os, const Territory& t) {
     os << "Territory(" << t.getName() << ", ID:" << t.getId() 
@@ -330,6 +2447,39 @@ std::ostream& operator<<(std::ostream& os, const Territory& t) {
     return os;
 }
 
+std::ostream& operator<<(std::ostream& os, const MapValidationReport& report) {
+    os << "MapValidationReport(connected:" << (report.connected ? "yes" : "no") << " " << report.connectedMs << "ms"
+       << ", continentsConnected:" << (report.continentsConnected ? "yes" : "no") << " " << report.continentsMs << "ms"
+       << ", uniqueContinents:" << (report.uniqueContinents ? "yes" : "no") << " " << report.uniqueContinentsMs << "ms)";
+    return os;
+}
+
+bool MapDiff::empty() const {
+    return addedContinents.empty() && changedBonuses.empty() && removedContinents.empty() && addedTerritories.empty() &&
+           changedTerritories.empty() && removedTerritories.empty() && addedEdges.empty() && removedEdges.empty();
+}
+
+std::ostream& operator<<(std::ostream& os, const MapDiff& diff) {
+    os << "MapDiff(Continents: +" << diff.addedContinents.size() << " -" << diff.removedContinents.size() << " ~"
+       << diff.changedBonuses.size() << ", Territories: +" << diff.addedTerritories.size() << " -"
+       << diff.removedTerritories.size() << " ~" << diff.changedTerritories.size() << ", Edges: +"
+       << diff.addedEdges.size() << " -" << diff.removedEdges.size() << ")";
+    return os;
+}
+
+std::ostream& operator<<(std::ostream& os, const MapLoadResult& result) {
+    os << "MapLoadResult(" << result.file << ", " << (result.valid ? "valid" : "invalid");
+    if (!result.valid) os << ": " << result.reason;
+    os << ", Territories:" << result.territories << ", Continents:" << result.continents
+       << ", parse " << result.parseMs << "ms, validate " << result.validateMs << "ms)";
+    return os;
+}
+
+std::ostream& operator<<(std::ostream& os, const TerritoryState& state) {
+    os << "TerritoryState(Territories:" << state.size() << ", Owners:" << state.getPlayers().size() << ")";
+    return os;
+}
+
 std::ostream& operator<<(std::ostream& os, const Continent& c) {
     os << "Continent(" << c.getName() << ", Territories:" << c.getTerritories().size() << ")";
     return os;
@@ -6,28 +6,173 @@
 #include <map>
 #include <set>
 #include <iostream>
+#include <sstream>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <string_view>
+#include <unordered_map>
+#include "MapArena.h"
 
 class Continent;
 class Player;
+class Territory;
+class Map;
+class MapDistanceIndex;
+class MapPartition;
+struct MapDiff;
+
+// Read-only range of territories. Map-bound ranges hold dense territory ids that are
+// resolved through the owning map's id table; free-standing ranges walk a pointer list.
+class TerritorySpan {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Territory*;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Territory* const*;
+        using reference = Territory*;
+
+        iterator(const int* ids, Territory* const* table, Territory* const* items, size_t index)
+            : ids(ids), table(table), items(items), index(index) {}
+        Territory* operator*() const { return ids ? table[ids[index]] : items[index]; }
+        iterator& operator++() { ++index; return *this; }
+        iterator operator++(int) { iterator old = *this; ++index; return old; }
+        bool operator==(const iterator& other) const { return index == other.index; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+
+    private:
+        const int* ids;
+        Territory* const* table;
+        Territory* const* items;
+        size_t index;
+    };
+
+    TerritorySpan() : ids(nullptr), table(nullptr), items(nullptr), count(0) {}
+    TerritorySpan(const int* ids, size_t count, Territory* const* table)
+        : ids(ids), table(table), items(nullptr), count(count) {}
+    TerritorySpan(Territory* const* items, size_t count)
+        : ids(nullptr), table(nullptr), items(items), count(count) {}
+
+    Territory* operator[](size_t i) const { return ids ? table[ids[i]] : items[i]; }
+    iterator begin() const { return iterator(ids, table, items, 0); }
+    iterator end() const { return iterator(ids, table, items, count); }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    std::vector<Territory*> toVector() const { return std::vector<Territory*>(begin(), end()); }
+
+    // Dense ids backing this range, or nullptr for a free-standing pointer list
+    const int* getIds() const { return ids; }
+
+private:
+    const int* ids;
+    Territory* const* table;
+    Territory* const* items;
+    size_t count;
+};
+
+// Mutable per-territory game state kept as parallel arrays indexed by territory id,
+// separate from the static topology so whole-board scans walk packed memory.
+// Copies share the continent membership arrays until one side changes them.
+class TerritoryState {
+public:
+    TerritoryState();
+    TerritoryState(const TerritoryState& other);  // Copy constructor
+    TerritoryState& operator=(const TerritoryState& other);  // Assignment operator
+    ~TerritoryState() {}
+
+    void addSlot(int id, Player* owner, int armies);   // Registers territory id with its initial state
+    void removeSlot(int id);                            // Marks id unused, dropping its owner and continent
+    void renumber(const std::vector<int>& newIds);      // Moves each id's state to newIds[id]
+    void clear();
+    int size() const;
+
+    Player* getOwner(int id) const;
+    void setOwner(int id, Player* p);
+    int getArmies(int id) const;
+    void setArmies(int id, int n);
+
+    // Bumped on every owner or army write to the id, so a reader can tell whether a
+    // territory changed since it last looked. The owner version only moves when the
+    // owner actually changes. Versions never go down.
+    uint32_t getVersion(int id) const;
+    uint32_t getOwnerVersion(int id) const;
+
+    // Owner indices refer to getPlayers(); -1 means unowned
+    int getOwnerIndex(int id) const;
+    int findPlayerIndex(const Player* p) const;
+    const std::vector<Player*>& getPlayers() const;
+
+    int countOwnedBy(const Player* p) const;
+    std::vector<int> countByOwner() const;      // Territory count per owner index, one sweep
+    Player* getSoleOwner() const;               // Player holding every territory, or nullptr
+
+    // Continent membership, with a per-continent holder kept up to date on every
+    // ownership change so "who holds this continent" is O(1)
+    int addContinent();                              // Returns the new continent's index
+    void assignContinent(int id, int continent);
+    int getContinentOf(int id) const;                // Continent index, or -1
+    int getContinentCount() const;
+    int getContinentOwnerIndex(int continent) const; // Owner index, or -1 unless fully held
+    Player* getContinentOwner(int continent) const;
+
+    friend std::ostream& operator<<(std::ostream& os, const TerritoryState& state);
+
+private:
+    static constexpr int16_t kUnowned = -1;
+    static constexpr int16_t kNoTerritory = -2;    // id not used by any territory
+
+    std::vector<Player*> players;
+    std::vector<int16_t> ownerIdx;
+    std::vector<int> armies;
+    std::vector<uint32_t> versions;
+    std::vector<uint32_t> ownerVersions;
+
+    struct Membership {
+        std::vector<int> continentOf;            // continent index per territory id, -1 if none
+        std::vector<int> continentSize;
+    };
+    std::shared_ptr<Membership> membership;
+    std::vector<int16_t> continentHolder;        // owner index holding the whole continent, or -1
+    std::vector<std::vector<int>> heldCount;     // [owner index][continent] territories held
+
+    Membership& editMembership();
+    int16_t indexFor(Player* p);
+    void countHeld(int continent, int16_t owner, int delta);
+};
 
 class Territory {
 public:
-    Territory(int id, const std::string& name, Continent* continent);
+    Territory(int id, const std::string& name, Continent* continent, int x = 0, int y = 0);
+    // Copies are free-standing snapshots: they carry the owner, armies and adjacency
+    // of the original but are not bound to its map
     Territory(const Territory& other);  // Copy constructor       
     Territory& operator=(const Territory& other);  // Assignment operator
     ~Territory() {};                              
 
     int getId() const;
-    std::string getName() const;
+    std::string_view getName() const;       // valid until the map's structure changes
     Continent* getContinent() const;
+    int getX() const;
+    int getY() const;
 
+    // Adjacency is read from the owning map's CSR table once Map::buildAdjacency has run;
+    // before that (or for territories outside a map) the local list is used
     void addAdjacentTerritory(Territory* t);
-    const std::vector<Territory*>& getAdjacents() const;
+    TerritorySpan getAdjacents() const;
 
+    // Owner and armies live in the owning map's TerritoryState, and name and
+    // coordinates in its topology; the local fields are only used while the
+    // territory is not part of a map
     void setOwner(Player* p);
     Player* getOwner() const;
     void setArmies(int n);
     int getArmies() const;
+    uint32_t getVersion() const;        // see TerritoryState::getVersion
+    uint32_t getOwnerVersion() const;
 
     friend std::ostream& operator<<(std::ostream& os, const Territory& t);
 
@@ -35,19 +180,29 @@ private:
     int id;
     std::string name;
     Continent* continent;
+    int x;
+    int y;
+    Map* map;
     std::vector<Territory*> adjacents;
     Player* owner;
     int armies;
+    uint32_t version;
+    uint32_t ownerVersion;
+
+    friend class Map;
 };
 
 class Continent {
 public:
-    Continent(const std::string& name);
+    Continent(const std::string& name, int bonus = 0);
+    // Copies are free-standing, like Territory copies
     Continent(const Continent& other);  // Copy constructor
     Continent& operator=(const Continent& other);  // Assignment operator
     ~Continent() {};                                  
 
-    std::string getName() const;
+    // Read from the owning map's string table once the continent is added to a map
+    std::string_view getName() const;
+    int getBonus() const;
     void addTerritory(Territory* t);
     const std::vector<Territory*>& getTerritories() const;
 
@@ -55,43 +210,276 @@ public:
 
 private:
     std::string name;
+    int bonus;
     std::vector<Territory*> territories; 
+    Map* map;
+    int index;                                  // continent index in map
+
+    friend class Map;
+    friend class MapLoader;
+};
+
+// Outcome and wall-clock cost of each Map::validate check
+struct MapValidationReport {
+    bool connected = false;
+    bool continentsConnected = false;
+    bool uniqueContinents = false;
+    double connectedMs = 0.0;
+    double continentsMs = 0.0;
+    double uniqueContinentsMs = 0.0;
+
+    bool isValid() const;
+    friend std::ostream& operator<<(std::ostream& os, const MapValidationReport& report);
+};
+
+// The parts of a map that do not change during a game: territory and continent names,
+// coordinates by territory id, the name index and the CSR adjacency table. Copies of a Map share
+// one topology and the first structural edit on either side takes a private copy.
+struct MapTopology {
+    MapTopology() {}
+    MapTopology(const MapTopology& other);  // Copy constructor; names are copied into the new arena
+    MapTopology& operator=(const MapTopology& other) = delete;
+
+    MapArena strings;                           // interned names, each stored once
+    std::vector<int> territoryIds;              // ids in getTerritories() order
+    std::vector<std::string_view> names;
+    std::vector<std::string_view> continentNames;   // by continent index
+    std::vector<int> coordinates;               // x, y pairs
+    std::vector<int> nameSlots;                 // open-addressing name index into territories, -1 = empty
+    std::vector<int> adjacencyOffsets;          // CSR row starts, one per id plus a sentinel
+    std::vector<int> adjacencyTargets;          // neighbour ids, in file order within each row
+    std::shared_ptr<const MapDistanceIndex> distanceIndex;  // built on first use, dropped on any edit
+    std::shared_ptr<const MapPartition> partition;          // same
+    // Edges between each pair of continents, keyed lower index << 32 | higher index.
+    // Built by the first applyDiff and kept up to date by later ones
+    std::shared_ptr<const std::unordered_map<uint64_t, int>> continentLinks;
+};
+
+// Territory id order for Map::renumber and MapLoader
+enum class MapOrdering {
+    File,               // ids in the order territories appear in the file
+    Bfs,                // breadth-first from a peripheral territory
+    ReverseCuthillMcKee // breadth-first visiting low-degree neighbours first, then reversed
 };
 
 class Map {
 public:
     Map();
+    // Copies share the topology and duplicate only the TerritoryState and the continent
+    // handles. Territory handles are laid out the first time the copy is asked for one,
+    // so a fork that is only read and written through getState() never builds them.
+    // That first access is not thread-safe.
     Map(const Map& other);  // Copy constructor
     Map& operator=(const Map& other);  // Assignment operator
     ~Map();                           
 
     void addContinent(Continent* c);
     void addTerritory(Territory* t);
-    Territory* getTerritory(int id) const;
+    Territory* getTerritory(int id) const;                      // O(1) through the dense id table
+    Territory* getTerritoryByName(std::string_view name) const; // O(1) average through the name index
 
     const std::vector<Continent*>& getContinents() const;
     const std::vector<Territory*>& getTerritories() const;
 
-    bool validate() const;
+    // Continent indices follow getContinents(); -1 for continents not in this map
+    int getContinentIndex(const Continent* c) const;
+    Player* getContinentOwner(const Continent* c) const;   // O(1), nullptr unless fully held
+
+    // Freezes adjacency into compressed-sparse-row form. Edges are undirected id pairs;
+    // any adjacency already recorded on the territories themselves is folded in as well
+    void buildAdjacency(const std::vector<std::pair<int, int>>& edges);
+    TerritorySpan getAdjacents(int id) const;
+    const std::vector<int>& getAdjacencyOffsets() const;
+    const std::vector<int>& getAdjacencyTargets() const;
+    bool hasAdjacency() const;
+
+    // Hop distances between territory ids, built on the first call and shared with
+    // copies of this map until either side changes its structure. Not thread-safe.
+    const MapDistanceIndex& getDistanceIndex() const;
+    // Regions for per-thread work with the default MapPartitionOptions, cached the same way
+    const MapPartition& getPartition() const;
+
+    TerritoryState& getState();
+    const TerritoryState& getState() const;
+
+    // Maps built by MapLoader carry the result of the checks made while parsing, and
+    // validate() returns it until the map's structure changes; forceFullCheck reruns
+    // the graph checks regardless
+    bool validate(MapValidationReport* report = nullptr, bool forceFullCheck = false) const;
+
+    // Apply a diff made by MapLoader::diff against this map. Surviving territories keep
+    // their ids, new ones take ids past the current ones and the CSR table is patched in
+    // one pass. When the map was valid before, only the continents the diff touches are
+    // checked again, and whole-map connectivity comes from the edges between continents;
+    // otherwise the full checks run. Removed continents are left to a full reload.
+    // Removed territories are destroyed, so any pointers to them must be dropped first.
+    bool applyDiff(const MapDiff& diff, MapValidationReport* report = nullptr);
+
+    // Give territories new ids in the given order so that neighbours get nearby ids, which
+    // keeps the adjacency rows and state arrays a traversal touches close together.
+    // getTerritories() and each continent's list follow the new ids, unused ids move to
+    // the end, and the cached distance index and partition are dropped. Territory pointers
+    // stay valid but their ids change, and copies taken earlier keep the old ids.
+    // Returns false, leaving the map as it was, for File order, without an adjacency table
+    // or when the map holds territories it does not own.
+    bool renumber(MapOrdering ordering);
 
     friend std::ostream& operator<<(std::ostream& os, const Map& map);
 
 private:
     std::vector<Continent*> continents;
-    std::vector<Territory*> territories;
+    mutable std::vector<Territory*> territories;
+    mutable std::vector<Territory*> territoryTable;     // indexed by territory id, nullptr for unused ids
+    std::unordered_map<const Continent*, int> continentIndex;
+    std::shared_ptr<MapTopology> topology;
+    TerritoryState state;
+
+    // Continents and territories the map creates itself (loaded maps and copies) are
+    // carved from the arena, each continent's territories side by side, and go away
+    // with it in one release. Objects added by pointer are deleted individually.
+    mutable MapArena arena;
+
+    mutable bool handlesPending;                // copy whose territory handles are not built yet
+    int looseTerritories;                       // territories without an id or outside this map's continents
 
+    bool hasLoadReport;                         // loadReport still describes this map
+    MapValidationReport loadReport;
+
+    // A territory for addTerritories; continent indexes getContinents(), -1 for none
+    struct TerritorySeed {
+        int id;
+        std::string_view name;
+        int continent;
+        int x;
+        int y;
+    };
+
+    MapTopology& editTopology();
+    void ensureHandles() const;
+    void buildHandles() const;
+    void addTerritories(const std::vector<TerritorySeed>& seeds, bool buildNameIndex);
+    void registerContinent(Continent* c, std::string_view name);
+    void registerTerritory(Territory* t, std::string_view name);
+    void indexName(size_t position);
+    void unindexName(size_t slot);
+    void removeTerritory(int id);
+    void applyRenumbering(const std::vector<int>& newIds);
+    void spliceAdjacency(std::vector<std::pair<int, int>>& drops, std::vector<std::pair<int, int>>& adds);
+    std::unordered_map<uint64_t, int> countContinentLinks() const;
+    void rebuildNameIndex(size_t capacity);
+    void release();
+    void copyFrom(const Map& other);
+    bool isSubgraphConnected(const std::vector<Territory*>& nodes, std::vector<uint64_t>& allowed,
+                             std::vector<uint64_t>& visited, std::vector<int>& frontier) const;
     bool isConnectedGraph() const;
     bool continentsAreConnected() const;
     bool territoriesHaveUniqueContinent() const;
+
+    friend class Territory;
+    friend class Continent;
+    friend class MapLoader;
+    friend class MapDistanceIndex;
+    friend class MapPartition;
+};
+
+// How MapLoader reads a .map file from disk (.wzmap files are always memory-mapped)
+enum class MapLoadMode {
+    Stream,     // std::getline over an ifstream
+    Mapped      // memory-mapped file tokenized in place with std::string_view
+};
+
+// Outcome of loading one map file, as reported by MapLoader::loadBatch
+struct MapLoadResult {
+    std::string file;
+    bool valid = false;
+    std::string reason;         // first error, empty for valid maps
+    int territories = 0;        // 0 when the file could not be parsed
+    int continents = 0;
+    double parseMs = 0.0;
+    double validateMs = 0.0;
+
+    friend std::ostream& operator<<(std::ostream& os, const MapLoadResult& result);
+};
+
+// What changed between a loaded map and a newer version of its file, by name
+struct MapDiff {
+    struct ContinentEntry {
+        std::string name;
+        int bonus;
+    };
+    struct TerritoryEntry {
+        std::string name;
+        std::string continent;
+        int x;
+        int y;
+    };
+
+    std::vector<ContinentEntry> addedContinents;
+    std::vector<ContinentEntry> changedBonuses;
+    std::vector<std::string> removedContinents;
+    std::vector<TerritoryEntry> addedTerritories;
+    std::vector<TerritoryEntry> changedTerritories;     // new continent or coordinates
+    std::vector<std::string> removedTerritories;
+    std::vector<std::pair<std::string, std::string>> addedEdges;
+    std::vector<std::pair<std::string, std::string>> removedEdges;   // between surviving territories
+
+    bool empty() const;
+    friend std::ostream& operator<<(std::ostream& os, const MapDiff& diff);
 };
 
 class MapLoader {
 public:
     MapLoader();
-    Map* loadMap(const std::string& filename);
+    explicit MapLoader(MapLoadMode mode);
+    Map* loadMap(const std::string& filename);     // .wzmap files take the compiled path
+    // Same, and fills result whether or not the map is valid
+    Map* loadMap(const std::string& filename, MapLoadResult* result);
+
+    // Load and validate every file concurrently on the shared thread pool, each with
+    // its own quiet loader; results come back in input order and no maps are kept
+    std::vector<MapLoadResult> loadBatch(const std::vector<std::string>& files) const;
+    // .map and .wzmap files directly inside a directory, sorted by name
+    static std::vector<std::string> listMapFiles(const std::string& directory);
+
+    // Compare a text map file with a map loaded from an earlier version of it
+    bool diff(const Map& map, const std::string& filename, MapDiff& diff);
+    // Bring a loaded map up to date with its file by applying only what changed, or by
+    // a full load when continents were removed. Returns false when the file cannot be
+    // read (the map is left as it was) or the updated map is invalid.
+    bool reload(Map& map, const std::string& filename, MapDiff* applied = nullptr);
+
+    // Load and validate a text map, then write it in the binary .wzmap format
+    bool compile(const std::string& textFile, const std::string& compiledFile);
+
+    MapLoadMode getMode() const;
+    void setMode(MapLoadMode mode);
+    // Id order applied to every map this loader returns; File (the default) keeps file order
+    MapOrdering getOrdering() const;
+    void setOrdering(MapOrdering ordering);
+
+    // A quiet loader keeps its errors in getLastError() instead of printing them
+    bool isQuiet() const;
+    void setQuiet(bool quiet);
+    const std::string& getLastError() const;
 
 private:
+    MapLoadMode mode;
+    MapOrdering ordering;
+    bool quiet;
+    std::string lastError;
+
+    template <typename... Parts>
+    void reportError(const Parts&... parts) {
+        std::ostringstream message;
+        (message << ... << parts);
+        lastError = message.str();
+        if (!quiet) std::cout << lastError << std::endl;
+    }
+
+    void reportInvalid(const MapValidationReport& report);
     Map* parseFile(const std::string& filename);
+    Map* parseMappedFile(const std::string& filename);
+    Map* loadCompiledFile(const std::string& filename);
 };
 
 #endif
@@ -0,0 +1,68 @@
+#include "MapArena.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+MapArena::MapArena(size_t firstBlockSize)
+    : offset(0), nextBlockSize(std::max<size_t>(firstBlockSize, 256)), used(0) {}
+
+MapArena::~MapArena() {}
+
+// Blocks double in size, so a map of n objects needs O(log n) of them
+void MapArena::addBlock(size_t minimum) {
+    size_t size = std::max(nextBlockSize, minimum);
+    blocks.push_back({std::unique_ptr<char[]>(new char[size]), size});
+    offset = 0;
+    nextBlockSize = size * 2;
+}
+
+void* MapArena::allocate(size_t bytes, size_t alignment) {
+    if (!blocks.empty()) {
+        uintptr_t base = reinterpret_cast<uintptr_t>(blocks.back().data.get());
+        size_t aligned = ((base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+        if (aligned + bytes <= blocks.back().size) {
+            offset = aligned + bytes;
+            used += bytes;
+            return blocks.back().data.get() + aligned;
+        }
+    }
+    // new char[] is aligned for any fundamental type, so a fresh block needs no padding
+    addBlock(bytes + alignment);
+    offset = bytes;
+    used += bytes;
+    return blocks.back().data.get();
+}
+
+std::string_view MapArena::copy(std::string_view text) {
+    if (text.empty()) return std::string_view();
+    char* p = static_cast<char*>(allocate(text.size(), 1));
+    std::memcpy(p, text.data(), text.size());
+    return std::string_view(p, text.size());
+}
+
+void MapArena::reserve(size_t bytes) {
+    if (blocks.empty() || blocks.back().size - offset < bytes) addBlock(bytes + alignof(std::max_align_t));
+}
+
+bool MapArena::owns(const void* p) const {
+    std::less<const void*> before;
+    for (const Block& block : blocks) {
+        if (!before(p, block.data.get()) && before(p, block.data.get() + block.size)) return true;
+    }
+    return false;
+}
+
+size_t MapArena::bytesUsed() const { return used; }
+size_t MapArena::blockCount() const { return blocks.size(); }
+
+void MapArena::release() {
+    blocks.clear();
+    offset = 0;
+    used = 0;
+}
+
+std::ostream& operator<<(std::ostream& os, const MapArena& arena) {
+    os << "MapArena(Bytes:" << arena.bytesUsed() << ", Blocks:" << arena.blockCount() << ")";
+    return os;
+}
@@ -0,0 +1,58 @@
+#ifndef MAP_ARENA_H
+#define MAP_ARENA_H
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Monotonic allocator for the objects that make up a map. Memory is carved from a
+// few large blocks and only given back all at once by release(); nothing is freed
+// individually. Objects created here do not have their destructors run by the
+// arena, so owners must destroy any that hold resources before releasing it.
+class MapArena {
+public:
+    explicit MapArena(size_t firstBlockSize = 4096);
+    MapArena(const MapArena& other) = delete;
+    MapArena& operator=(const MapArena& other) = delete;
+    ~MapArena();
+
+    void* allocate(size_t bytes, size_t alignment);
+
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // Copy text into the arena; the view stays valid until release()
+    std::string_view copy(std::string_view text);
+
+    // Make sure the next allocations totalling up to bytes land in one block
+    void reserve(size_t bytes);
+
+    bool owns(const void* p) const;
+    size_t bytesUsed() const;
+    size_t blockCount() const;
+
+    void release();
+
+    friend std::ostream& operator<<(std::ostream& os, const MapArena& arena);
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+    size_t offset;              // first free byte in the last block
+    size_t nextBlockSize;
+    size_t used;
+
+    void addBlock(size_t minimum);
+};
+
+#endif
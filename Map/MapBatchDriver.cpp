@@ -0,0 +1,68 @@
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Map.h"
+
+namespace {
+    void printBatchUsage() {
+        std::cout << "Usage: MapBatch <directory or file>... [--mode stream|mapped]" << std::endl;
+    }
+}
+
+// Loads and validates every map named on the command line (directories are expanded
+// to the .map and .wzmap files inside them) and prints one report line per file.
+// Returns 1 when any file is invalid.
+int runMapBatch(int argc, char* argv[]) {
+    std::vector<std::string> files;
+    MapLoadMode mode = MapLoadMode::Mapped;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--mode" && i + 1 < argc) {
+            std::string value = argv[++i];
+            if (value == "stream") mode = MapLoadMode::Stream;
+            else if (value == "mapped") mode = MapLoadMode::Mapped;
+            else {
+                printBatchUsage();
+                return 1;
+            }
+        } else if (std::filesystem::is_directory(arg)) {
+            std::vector<std::string> listed = MapLoader::listMapFiles(arg);
+            files.insert(files.end(), listed.begin(), listed.end());
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) {
+        printBatchUsage();
+        return 1;
+    }
+
+    MapLoader loader(mode);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<MapLoadResult> results = loader.loadBatch(files);
+    double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::left << std::setw(40) << "file" << std::setw(9) << "status" << std::right << std::setw(12)
+              << "territories" << std::setw(12) << "continents" << std::setw(11) << "parse ms" << std::setw(13)
+              << "validate ms" << "  reason" << std::endl;
+    int invalid = 0;
+    for (const MapLoadResult& result : results) {
+        if (!result.valid) invalid++;
+        std::cout << std::left << std::setw(40) << result.file << std::setw(9) << (result.valid ? "valid" : "invalid")
+                  << std::right << std::setw(12) << result.territories << std::setw(12) << result.continents
+                  << std::fixed << std::setprecision(3) << std::setw(11) << result.parseMs << std::setw(13)
+                  << result.validateMs << "  " << result.reason << std::endl;
+    }
+    std::cout << results.size() - invalid << " valid, " << invalid << " invalid, " << std::setprecision(1) << wallMs
+              << " ms wall clock" << std::endl;
+    return invalid > 0 ? 1 : 0;
+}
+
+#ifndef MAIN_DRIVER_INCLUDED
+int main(int argc, char* argv[]) {
+    return runMapBatch(argc, argv);
+}
+#endif
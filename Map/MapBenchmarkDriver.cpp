@@ -0,0 +1,552 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <queue>
+#include <unordered_set>
+#include <vector>
+#include "Map.h"
+#include "MapDistanceIndex.h"
+#include "MapGenerator.h"
+#include "MapPartition.h"
+
+namespace {
+    // Writes a valid Conquest-format grid map with MapGenerator (degree 4, fixed seed)
+    std::string writeGridMap(int territories, int continents) {
+        std::string filename = "synthetic_" + std::to_string(territories) + ".map";
+        MapGeneratorOptions options;
+        options.territories = territories;
+        options.continents = continents;
+        options.averageDegree = 4.0;
+        options.topology = GeneratedTopology::Grid;
+        MapGenerator generator(options);
+        generator.write(filename);
+        return filename;
+    }
+
+    // Average wall-clock milliseconds of loadMap over a number of repetitions
+    double timeLoad(MapLoader& loader, const std::string& file, int repetitions) {
+        double total = 0.0;
+        for (int i = 0; i < repetitions; i++) {
+            auto start = std::chrono::steady_clock::now();
+            Map* map = loader.loadMap(file);
+            auto end = std::chrono::steady_clock::now();
+            total += std::chrono::duration<double, std::milli>(end - start).count();
+            delete map;
+        }
+        return total / repetitions;
+    }
+
+    void reportLoad(const std::string& label, const std::string& file, int repetitions) {
+        MapLoader streamLoader(MapLoadMode::Stream);
+        MapLoader mappedLoader(MapLoadMode::Mapped);
+        double streamMs = timeLoad(streamLoader, file, repetitions);
+        double mappedMs = timeLoad(mappedLoader, file, repetitions);
+
+        std::string compiled = "benchmark.wzmap";
+        double compiledMs = mappedLoader.compile(file, compiled) ? timeLoad(mappedLoader, compiled, repetitions) : 0.0;
+        std::remove(compiled.c_str());
+
+        std::cout << std::left << std::setw(24) << label << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(12) << streamMs << std::setw(12) << mappedMs << std::setw(12) << compiledMs
+                  << std::setw(9) << std::setprecision(2) << (compiledMs > 0.0 ? streamMs / compiledMs : 0.0) << "x" << std::endl;
+    }
+}
+
+namespace {
+    // Builds a map of free-floating territories; lookups do not need adjacency
+    Map* buildLookupMap(int territories) {
+        Map* map = new Map();
+        Continent* continent = new Continent("Lookup");
+        map->addContinent(continent);
+        for (int i = 0; i < territories; i++) {
+            Territory* t = new Territory(i, "Territory " + std::to_string(i), continent);
+            continent->addTerritory(t);
+            map->addTerritory(t);
+        }
+        return map;
+    }
+
+    template <typename Lookup>
+    double nanosPerLookup(const std::vector<int>& keys, Lookup lookup) {
+        size_t found = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int key : keys) {
+            if (lookup(key)) found++;
+        }
+        auto end = std::chrono::steady_clock::now();
+        if (found != keys.size()) std::cout << "  (missed " << keys.size() - found << " lookups)" << std::endl;
+        return std::chrono::duration<double, std::nano>(end - start).count() / keys.size();
+    }
+}
+
+// Times Map::getTerritory / getTerritoryByName against the old linear scan
+void testTerritoryLookupBenchmark() {
+    std::cout << "\n=== Territory Lookup Benchmark (ns per lookup) ===" << std::endl;
+    std::cout << std::left << std::setw(14) << "territories" << std::right
+              << std::setw(14) << "linear scan" << std::setw(12) << "by id" << std::setw(12) << "by name" << std::endl;
+
+    std::mt19937 rng(345);
+    for (int size : {10000, 100000, 1000000}) {
+        Map* map = buildLookupMap(size);
+        std::uniform_int_distribution<int> pick(0, size - 1);
+
+        std::vector<int> keys(200000);
+        for (int& key : keys) key = pick(rng);
+        std::vector<int> scanKeys(keys.begin(), keys.begin() + 200);
+
+        std::vector<std::string> names;
+        names.reserve(keys.size());
+        for (int key : keys) names.push_back("Territory " + std::to_string(key));
+
+        double scanNs = nanosPerLookup(scanKeys, [&](int id) -> Territory* {
+            for (Territory* t : map->getTerritories()) {
+                if (t->getId() == id) return t;
+            }
+            return nullptr;
+        });
+        double idNs = nanosPerLookup(keys, [&](int id) { return map->getTerritory(id); });
+        size_t next = 0;
+        double nameNs = nanosPerLookup(keys, [&](int) { return map->getTerritoryByName(names[next++]); });
+
+        std::cout << std::left << std::setw(14) << size << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << scanNs << std::setw(12) << idNs << std::setw(12) << nameNs << std::endl;
+        delete map;
+    }
+}
+
+namespace {
+    // The original whole-graph check: BFS with hash-set visited/allowed sets
+    bool hashSetConnected(const Map& map) {
+        const std::vector<Territory*>& nodes = map.getTerritories();
+        if (nodes.empty()) return true;
+        std::unordered_set<int> visited;
+        std::queue<Territory*> q;
+        q.push(nodes[0]);
+        visited.insert(nodes[0]->getId());
+        while (!q.empty()) {
+            Territory* cur = q.front(); q.pop();
+            for (Territory* n : cur->getAdjacents()) {
+                if (visited.insert(n->getId()).second) q.push(n);
+            }
+        }
+        return visited.size() == nodes.size();
+    }
+}
+
+// Reports the cost of each Map::validate check next to the old hash-set BFS
+void testMapValidationBenchmark() {
+    std::cout << "\n=== Map::validate Benchmark (ms per check) ===" << std::endl;
+    std::cout << std::left << std::setw(20) << "map" << std::right << std::setw(14) << "hash-set BFS"
+              << std::setw(12) << "union-find" << std::setw(12) << "continents" << std::setw(10) << "unique" << std::endl;
+
+    MapLoader loader(MapLoadMode::Mapped);
+    auto report = [&](const std::string& label, const std::string& file) {
+        Map* map = loader.loadMap(file);
+        if (!map) return;
+        auto start = std::chrono::steady_clock::now();
+        hashSetConnected(*map);
+        double hashMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        MapValidationReport result;
+        map->validate(&result, true);
+        std::cout << std::left << std::setw(20) << label << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(14) << hashMs << std::setw(12) << result.connectedMs
+                  << std::setw(12) << result.continentsMs << std::setw(10) << result.uniqueContinentsMs
+                  << (result.isValid() ? "" : "  (invalid)") << std::endl;
+        delete map;
+    };
+
+    report("canada.map", "Map/canada.map");
+    for (int size : {100000, 1000000}) {
+        std::string file = writeGridMap(size, 64);
+        report("synthetic " + std::to_string(size), file);
+        std::remove(file.c_str());
+    }
+}
+
+namespace {
+    template <typename Action>
+    double microsPerCall(int repetitions, Action action) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; i++) action();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / repetitions;
+    }
+
+    // A fork must not see changes made to the board it was taken from, and vice versa
+    bool forkIsIndependent(Map& map) {
+        Territory* original = map.getTerritories().front();
+        int armies = original->getArmies();
+        Map fork(map);
+        Territory* copy = fork.getTerritory(original->getId());
+        copy->setArmies(armies + 7);
+        bool independent = copy != original && copy->getName() == original->getName() &&
+                           original->getArmies() == armies && copy->getArmies() == armies + 7 &&
+                           copy->getContinent() == fork.getContinents()[map.getContinentIndex(original->getContinent())];
+        for (Territory* n : copy->getAdjacents()) independent = independent && n == fork.getTerritory(n->getId());
+        return independent;
+    }
+}
+
+// Cost of forking a loaded board (Map copy), with and without laying out its territory
+// handles, next to copying its state arrays alone
+void testMapForkBenchmark() {
+    std::cout << "\n=== Map Fork Benchmark (us per fork) ===" << std::endl;
+    std::cout << std::left << std::setw(20) << "map" << std::right << std::setw(12) << "fork"
+              << std::setw(16) << "fork+handles" << std::setw(12) << "state only" << std::setw(14) << "independent" << std::endl;
+
+    MapLoader loader(MapLoadMode::Mapped);
+    auto report = [&](const std::string& label, const std::string& file, int repetitions) {
+        Map* map = loader.loadMap(file);
+        if (!map) return;
+        double forkUs = microsPerCall(repetitions, [&]() { Map fork(*map); });
+        double handlesUs = microsPerCall(repetitions, [&]() { Map fork(*map); fork.getTerritories(); });
+        double stateUs = microsPerCall(repetitions, [&]() { TerritoryState copy(map->getState()); });
+        std::cout << std::left << std::setw(20) << label << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << forkUs << std::setw(16) << handlesUs << std::setw(12) << stateUs
+                  << std::setw(14) << (forkIsIndependent(*map) ? "yes" : "NO") << std::endl;
+        delete map;
+    };
+
+    report("canada.map", "Map/canada.map", 10000);
+    std::string file = writeGridMap(100000, 64);
+    report("synthetic 100000", file, 50);
+    std::remove(file.c_str());
+}
+
+// Time to delete a loaded map, whose objects sit in its arena, against a map of the
+// same size whose territories were allocated one by one and added by pointer
+void testMapTeardownBenchmark() {
+    std::cout << "\n=== Map Teardown Benchmark (ms per delete) ===" << std::endl;
+    std::cout << std::left << std::setw(20) << "territories" << std::right << std::setw(12) << "arena"
+              << std::setw(12) << "per-object" << std::endl;
+
+    MapLoader loader(MapLoadMode::Mapped);
+    for (int size : {10000, 100000, 500000}) {
+        std::string file = writeGridMap(size, 50);
+        Map* loaded = loader.loadMap(file);
+        std::remove(file.c_str());
+        Map* built = buildLookupMap(size);
+        if (!loaded) {
+            delete built;
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        delete loaded;
+        double arenaMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        delete built;
+        double heapMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << std::left << std::setw(20) << size << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(12) << arenaMs << std::setw(12) << heapMs << std::endl;
+    }
+}
+
+namespace {
+    // Hop distance the way callers found it before the index: BFS from a until b is reached
+    int bfsDistance(const Map& map, int a, int b, std::vector<int>& hops, std::vector<int>& frontier) {
+        const std::vector<int>& offsets = map.getAdjacencyOffsets();
+        const std::vector<int>& targets = map.getAdjacencyTargets();
+        frontier.assign(1, a);
+        hops[a] = 0;
+        int found = a == b ? 0 : -1;
+        for (size_t head = 0; head < frontier.size() && found < 0; head++) {
+            int cur = frontier[head];
+            for (int i = offsets[cur]; i < offsets[cur + 1]; i++) {
+                int n = targets[i];
+                if (hops[n] >= 0) continue;
+                hops[n] = hops[cur] + 1;
+                if (n == b) found = hops[n];
+                frontier.push_back(n);
+            }
+        }
+        for (int id : frontier) hops[id] = -1;
+        return found;
+    }
+}
+
+// Building the distance index, and distance/nextHop queries against a BFS per query
+void testMapDistanceBenchmark() {
+    std::cout << "\n=== Map Distance Index Benchmark ===" << std::endl;
+    std::cout << std::left << std::setw(20) << "map" << std::right << std::setw(11) << "layout" << std::setw(12) << "build ms"
+              << std::setw(12) << "MB" << std::setw(14) << "distance ns" << std::setw(13) << "nextHop ns"
+              << std::setw(12) << "BFS us" << std::endl;
+
+    MapLoader loader(MapLoadMode::Mapped);
+    auto report = [&](const std::string& label, const std::string& file) {
+        Map* map = loader.loadMap(file);
+        if (!map) return;
+        auto start = std::chrono::steady_clock::now();
+        const MapDistanceIndex& index = map->getDistanceIndex();
+        double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        const int ids = index.getIdCount();
+        std::mt19937 rng(345);
+        std::vector<std::pair<int, int>> pairs(100000);
+        for (auto& p : pairs) p = {(int)(rng() % ids), (int)(rng() % ids)};
+
+        size_t unreachable = 0;
+        start = std::chrono::steady_clock::now();
+        for (const auto& p : pairs) {
+            if (index.distance(p.first, p.second) < 0) unreachable++;
+        }
+        double distanceNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / pairs.size();
+        start = std::chrono::steady_clock::now();
+        for (const auto& p : pairs) {
+            if (index.nextHop(p.first, p.second) < 0 && p.first != p.second) unreachable++;
+        }
+        double hopNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / pairs.size();
+
+        std::vector<int> hops(ids, -1);
+        std::vector<int> frontier;
+        const size_t bfsQueries = 200;
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < bfsQueries; i++) {
+            if (bfsDistance(*map, pairs[i].first, pairs[i].second, hops, frontier) < 0) unreachable++;
+        }
+        double bfsUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / bfsQueries;
+
+        std::cout << std::left << std::setw(20) << label << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(11) << (index.isExact() ? "matrix" : "landmarks") << std::setw(12) << buildMs
+                  << std::setw(12) << index.getMemoryBytes() / (1024.0 * 1024.0) << std::setw(14) << distanceNs
+                  << std::setw(13) << hopNs << std::setw(12) << bfsUs << std::endl;
+        if (unreachable > 0) std::cout << "  (" << unreachable << " unreachable answers)" << std::endl;
+        delete map;
+    };
+
+    report("canada.map", "Map/canada.map");
+    for (int size : {4000, 100000, 1000000}) {
+        std::string file = writeGridMap(size, 50);
+        report("synthetic " + std::to_string(size), file);
+        std::remove(file.c_str());
+    }
+}
+
+// Partitioning time and quality: cut edges and boundary territories against the total,
+// and the largest region against an even share
+void testMapPartitionBenchmark() {
+    std::cout << "\n=== Map Partition Benchmark ===" << std::endl;
+    std::cout << std::left << std::setw(20) << "map" << std::right << std::setw(9) << "regions" << std::setw(12)
+              << "build ms" << std::setw(11) << "cut %" << std::setw(12) << "boundary %" << std::setw(12)
+              << "imbalance" << std::endl;
+
+    MapLoader loader(MapLoadMode::Mapped);
+    auto report = [&](const std::string& label, const std::string& file) {
+        Map* map = loader.loadMap(file);
+        if (!map) return;
+        const double territories = (double)map->getTerritories().size();
+        const double edges = map->getAdjacencyTargets().size() / 2.0;
+        for (int regions : {4, 16, 64}) {
+            MapPartitionOptions options;
+            options.regions = regions;
+            auto start = std::chrono::steady_clock::now();
+            MapPartition partition(*map, options);
+            double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            size_t boundary = 0;
+            for (int r = 0; r < partition.getRegionCount(); r++) boundary += partition.getBoundaryTerritories(r).size();
+            std::cout << std::left << std::setw(20) << label << std::right << std::setw(9) << partition.getRegionCount()
+                      << std::fixed << std::setprecision(2) << std::setw(12) << buildMs << std::setw(11)
+                      << 100.0 * partition.getCutEdges() / edges << std::setw(12) << 100.0 * boundary / territories
+                      << std::setw(12) << partition.getLargestRegionSize() / (territories / partition.getRegionCount())
+                      << std::endl;
+        }
+        delete map;
+    };
+
+    report("canada.map", "Map/canada.map");
+    for (int size : {100000, 1000000}) {
+        std::string file = writeGridMap(size, 50);
+        report("synthetic " + std::to_string(size), file);
+        std::remove(file.c_str());
+    }
+}
+
+// Incremental reload after a one-territory edit against loading the edited file from
+// scratch. The diff still reads the whole file; applying it only touches what changed
+void testMapReloadBenchmark() {
+    std::cout << "\n=== Map Reload Benchmark (one territory added) ===" << std::endl;
+    std::cout << std::left << std::setw(20) << "map" << std::right << std::setw(12) << "full ms" << std::setw(12)
+              << "diff ms" << std::setw(12) << "apply ms" << std::setw(10) << "valid" << std::endl;
+
+    MapLoader loader(MapLoadMode::Mapped);
+    for (int size : {10000, 100000, 1000000}) {
+        std::string file = writeGridMap(size, 50);
+        Map* map = loader.loadMap(file);
+        if (!map) continue;
+
+        // The first reload also counts the edges between continents, so it is not timed
+        double fullMs = 0.0;
+        double diffMs = 0.0;
+        double applyMs = 0.0;
+        bool valid = false;
+        for (int outpost = 0; outpost < 2; outpost++) {
+            std::ofstream(file, std::ios::app) << "Outpost " << outpost << ",0,0,Continent 0,Territory 0\n";
+            auto start = std::chrono::steady_clock::now();
+            MapDiff diff;
+            loader.diff(*map, file, diff);
+            diffMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            start = std::chrono::steady_clock::now();
+            valid = map->applyDiff(diff);
+            applyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        fullMs = timeLoad(loader, file, 1);
+
+        std::cout << std::left << std::setw(20) << ("synthetic " + std::to_string(size)) << std::right << std::fixed
+                  << std::setprecision(3) << std::setw(12) << fullMs << std::setw(12) << diffMs << std::setw(12)
+                  << applyMs << std::setw(10) << (valid ? "yes" : "no") << std::endl;
+        delete map;
+        std::remove(file.c_str());
+    }
+}
+
+namespace {
+    // Generated planar map with its territory lines shuffled, so file order says nothing
+    // about which territories are neighbours
+    std::string writeShuffledMap(int territories, int continents) {
+        std::string filename = "synthetic_shuffled_" + std::to_string(territories) + ".map";
+        MapGeneratorOptions options;
+        options.territories = territories;
+        options.continents = continents;
+        options.averageDegree = 6.0;
+        options.topology = GeneratedTopology::Planar;
+        MapGenerator(options).write(filename);
+
+        std::vector<std::string> lines;
+        std::ifstream in(filename);
+        for (std::string line; std::getline(in, line);) lines.push_back(line);
+        in.close();
+        auto first = std::find(lines.begin(), lines.end(), "[Territories]");
+        if (first != lines.end()) std::shuffle(first + 1, lines.end(), std::mt19937(345));
+        std::ofstream out(filename);
+        for (const std::string& line : lines) out << line << "\n";
+        return filename;
+    }
+
+    // Full BFS from territory 0 over the CSR table, in milliseconds
+    double timeFullBfs(const Map& map) {
+        const std::vector<int>& offsets = map.getAdjacencyOffsets();
+        const std::vector<int>& targets = map.getAdjacencyTargets();
+        std::vector<char> seen(offsets.size() - 1, 0);
+        std::vector<int> frontier(1, map.getTerritories().front()->getId());
+        frontier.reserve(seen.size());
+        seen[frontier[0]] = 1;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t head = 0; head < frontier.size(); head++) {
+            int cur = frontier[head];
+            for (int i = offsets[cur]; i < offsets[cur + 1]; i++) {
+                if (!seen[targets[i]]) {
+                    seen[targets[i]] = 1;
+                    frontier.push_back(targets[i]);
+                }
+            }
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // The sweep an AI makes when picking targets: for every territory, the armies on
+    // neighbouring territories of other continents, read from the state arrays
+    double timeNeighbourScan(const Map& map, long long& checksum) {
+        const std::vector<int>& offsets = map.getAdjacencyOffsets();
+        const std::vector<int>& targets = map.getAdjacencyTargets();
+        const TerritoryState& state = map.getState();
+        checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int id = 0; id + 1 < (int)offsets.size(); id++) {
+            int continent = state.getContinentOf(id);
+            for (int i = offsets[id]; i < offsets[id + 1]; i++) {
+                if (state.getContinentOf(targets[i]) != continent) checksum += state.getArmies(targets[i]);
+            }
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+// Loads shuffled maps in file order and renumbered, and times what walks the adjacency:
+// a full validation, one BFS over the whole map and a neighbour scan over the state
+void testMapRenumberBenchmark() {
+    std::cout << "\n=== Map Renumbering Benchmark (shuffled planar maps) ===" << std::endl;
+    std::cout << std::left << std::setw(20) << "map" << std::right << std::setw(7) << "order" << std::setw(13)
+              << "renumber ms" << std::setw(11) << "mean gap" << std::setw(13) << "validate ms" << std::setw(10)
+              << "BFS ms" << std::setw(10) << "scan ms" << std::endl;
+
+    for (int size : {100000, 1000000}) {
+        std::string file = writeShuffledMap(size, 50);
+        long long expected = -1;
+        for (MapOrdering ordering : {MapOrdering::File, MapOrdering::Bfs, MapOrdering::ReverseCuthillMcKee}) {
+            MapLoader loader(MapLoadMode::Mapped);
+            Map* map = loader.loadMap(file);
+            if (!map) break;
+            for (Territory* t : map->getTerritories()) t->setArmies(t->getX() % 7 + 1);
+
+            auto start = std::chrono::steady_clock::now();
+            map->renumber(ordering);
+            double renumberMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            const std::vector<int>& offsets = map->getAdjacencyOffsets();
+            const std::vector<int>& targets = map->getAdjacencyTargets();
+            double gap = 0.0;
+            for (int id = 0; id + 1 < (int)offsets.size(); id++) {
+                for (int i = offsets[id]; i < offsets[id + 1]; i++) gap += std::abs(targets[i] - id);
+            }
+            gap /= targets.size();
+
+            start = std::chrono::steady_clock::now();
+            bool valid = map->validate(nullptr, true);
+            double validateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            double bfsMs = timeFullBfs(*map);
+            long long checksum = 0;
+            double scanMs = timeNeighbourScan(*map, checksum);
+            if (expected < 0) expected = checksum;
+
+            const char* name = ordering == MapOrdering::File ? "file" : ordering == MapOrdering::Bfs ? "bfs" : "rcm";
+            std::cout << std::left << std::setw(20) << ("synthetic " + std::to_string(size)) << std::right
+                      << std::setw(7) << name << std::fixed << std::setprecision(2) << std::setw(13) << renumberMs
+                      << std::setw(11) << gap << std::setw(13) << validateMs << std::setw(10) << bfsMs
+                      << std::setw(10) << scanMs << std::endl;
+            if (!valid || checksum != expected) std::cout << "  (renumbered map differs)" << std::endl;
+            delete map;
+        }
+        std::remove(file.c_str());
+    }
+}
+
+// Compares the getline-based loader, the memory-mapped loader and the compiled .wzmap loader
+void testMapLoaderBenchmark() {
+    std::cout << "=== MapLoader Benchmark (ms per loadMap) ===" << std::endl;
+    std::cout << std::left << std::setw(24) << "map" << std::right << std::setw(12) << "stream"
+              << std::setw(12) << "mapped" << std::setw(12) << "compiled" << std::setw(10) << "speedup" << std::endl;
+
+    reportLoad("Asia.map", "Map/Asia.map", 200);
+    reportLoad("Europe.map", "Map/Europe.map", 200);
+    reportLoad("canada.map", "Map/canada.map", 200);
+
+    for (int size : {10000, 100000, 500000}) {
+        std::string file = writeGridMap(size, 50);
+        reportLoad("synthetic " + std::to_string(size), file, size >= 500000 ? 1 : 3);
+        std::remove(file.c_str());
+    }
+}
+
+#ifndef MAIN_DRIVER_INCLUDED
+int main() {
+    testMapLoaderBenchmark();
+    testTerritoryLookupBenchmark();
+    testMapValidationBenchmark();
+    testMapForkBenchmark();
+    testMapTeardownBenchmark();
+    testMapDistanceBenchmark();
+    testMapPartitionBenchmark();
+    testMapReloadBenchmark();
+    testMapRenumberBenchmark();
+    return 0;
+}
+#endif
@@ -0,0 +1,216 @@
+#include "MapDistanceIndex.h"
+#include "Map.h"
+#include "../ThreadPool/ThreadPool.h"
+#include <algorithm>
+#include <climits>
+
+namespace {
+    // Below this many territories one thread finishes the matrix before the pool would
+    const int kParallelMatrixThreshold = 256;
+}
+
+MapDistanceIndex::MapDistanceIndex(const Map& map, const MapDistanceOptions& options)
+    : idCount(0), exact(true) {
+    if (map.hasAdjacency()) {
+        offsets = map.getAdjacencyOffsets();
+        targets = map.getAdjacencyTargets();
+        idCount = (int)offsets.size() - 1;
+    }
+    // Ids that are not territories report no distance, even to themselves
+    std::vector<int> territoryIds;
+    for (int id : map.topology->territoryIds) {
+        if (id >= 0 && id < idCount) territoryIds.push_back(id);
+    }
+
+    // Distances in the matrix have to stay below kFar
+    if (idCount <= std::min(std::max(0, options.matrixLimit), (int)kFar - 1)) {
+        buildMatrix(territoryIds);
+    } else {
+        exact = false;
+        buildLandmarks(territoryIds, std::max(1, options.landmarks));
+    }
+}
+
+// Copy constructor
+MapDistanceIndex::MapDistanceIndex(const MapDistanceIndex& other)
+    : idCount(other.idCount), exact(other.exact), offsets(other.offsets), targets(other.targets),
+      matrix(other.matrix), landmarks(other.landmarks), landmarkDistance(other.landmarkDistance),
+      nearestLandmark(other.nearestLandmark) {}
+
+// Assignment operator
+MapDistanceIndex& MapDistanceIndex::operator=(const MapDistanceIndex& other) {
+    if (this != &other) {
+        idCount = other.idCount;
+        exact = other.exact;
+        offsets = other.offsets;
+        targets = other.targets;
+        matrix = other.matrix;
+        landmarks = other.landmarks;
+        landmarkDistance = other.landmarkDistance;
+        nearestLandmark = other.nearestLandmark;
+    }
+    return *this;
+}
+
+// One BFS per id writing straight into its matrix row; rows are independent, so the
+// sources are dealt out to the pool workers round-robin
+void MapDistanceIndex::buildMatrix(const std::vector<int>& territoryIds) {
+    matrix.assign((size_t)idCount * idCount, kFar);
+    const size_t sources = territoryIds.size();
+    bool parallel = sources >= (size_t)kParallelMatrixThreshold;
+    size_t workers = parallel ? std::min(sources, ThreadPool::shared().size() + 1) : 1;
+
+    auto bfsSlice = [&](size_t slice) {
+        std::vector<int> frontier;
+        frontier.reserve(idCount);
+        for (size_t s = slice; s < sources; s += workers) {
+            int source = territoryIds[s];
+            uint16_t* row = matrix.data() + (size_t)source * idCount;
+            frontier.clear();
+            frontier.push_back(source);
+            row[source] = 0;
+            for (size_t head = 0; head < frontier.size(); head++) {
+                int cur = frontier[head];
+                uint16_t next = row[cur] + 1;
+                for (int i = offsets[cur]; i < offsets[cur + 1]; i++) {
+                    int n = targets[i];
+                    if (row[n] != kFar) continue;
+                    row[n] = next;
+                    frontier.push_back(n);
+                }
+            }
+        }
+    };
+
+    if (parallel) {
+        ThreadPool::shared().parallelFor(workers, bfsSlice);
+    } else {
+        bfsSlice(0);
+    }
+}
+
+// Farthest-first landmarks: each new landmark is the territory farthest from all the
+// previous ones, and a territory no landmark reaches always gets one, so every
+// connected component has at least one landmark
+void MapDistanceIndex::buildLandmarks(const std::vector<int>& territoryIds, int count) {
+    std::vector<int> closest(idCount, INT_MAX);
+    nearestLandmark.assign(idCount, -1);
+    std::vector<int> frontier;
+    frontier.reserve(idCount);
+
+    int next = territoryIds.empty() ? -1 : territoryIds[0];
+    while (next >= 0) {
+        int landmark = (int)landmarks.size();
+        landmarks.push_back(next);
+        landmarkDistance.resize(landmarkDistance.size() + idCount, -1);
+        int* row = landmarkDistance.data() + (size_t)landmark * idCount;
+
+        frontier.clear();
+        frontier.push_back(next);
+        row[next] = 0;
+        for (size_t head = 0; head < frontier.size(); head++) {
+            int cur = frontier[head];
+            for (int i = offsets[cur]; i < offsets[cur + 1]; i++) {
+                int n = targets[i];
+                if (row[n] >= 0) continue;
+                row[n] = row[cur] + 1;
+                frontier.push_back(n);
+            }
+        }
+        for (int id : frontier) {
+            if (row[id] < closest[id]) {
+                closest[id] = row[id];
+                nearestLandmark[id] = landmark;
+            }
+        }
+
+        next = -1;
+        int farthest = 0;
+        for (int id : territoryIds) {
+            if (nearestLandmark[id] < 0) {
+                next = id;
+                break;
+            }
+            if ((int)landmarks.size() < count && closest[id] > farthest) {
+                farthest = closest[id];
+                next = id;
+            }
+        }
+    }
+}
+
+int MapDistanceIndex::landmarkDistanceOf(int landmark, int id) const {
+    return landmarkDistance[(size_t)landmark * idCount + id];
+}
+
+// First neighbour (in CSR order) one hop closer to the landmark, so the landmark's
+// BFS tree is the same on every call
+int MapDistanceIndex::parentToward(int landmark, int id) const {
+    int d = landmarkDistanceOf(landmark, id);
+    for (int i = offsets[id]; i < offsets[id + 1]; i++) {
+        if (landmarkDistanceOf(landmark, targets[i]) == d - 1) return targets[i];
+    }
+    return -1;
+}
+
+int MapDistanceIndex::distance(int a, int b) const {
+    if (a < 0 || b < 0 || a >= idCount || b >= idCount) return -1;
+    if (exact) {
+        uint16_t d = matrix[(size_t)a * idCount + b];
+        return d == kFar ? -1 : d;
+    }
+
+    if (nearestLandmark[a] < 0 || nearestLandmark[b] < 0) return -1;
+    if (a == b) return 0;
+    int best = -1;
+    for (size_t l = 0; l < landmarks.size(); l++) {
+        int da = landmarkDistanceOf((int)l, a);
+        int db = landmarkDistanceOf((int)l, b);
+        if (da >= 0 && db >= 0 && (best < 0 || da + db < best)) best = da + db;
+    }
+    return best;
+}
+
+int MapDistanceIndex::nextHop(int a, int b) const {
+    int d = distance(a, b);
+    if (d <= 0) return -1;
+    if (exact) {
+        for (int i = offsets[a]; i < offsets[a + 1]; i++) {
+            if (distance(targets[i], b) == d - 1) return targets[i];
+        }
+        return -1;
+    }
+
+    // Route through the BFS tree of b's nearest landmark: climb towards the landmark
+    // until a lies on the tree path to b, then follow that path down to b
+    int landmark = nearestLandmark[b];
+    int da = landmarkDistanceOf(landmark, a);
+    int db = landmarkDistanceOf(landmark, b);
+    if (da < db) {
+        int child = b;
+        int cur = b;
+        for (int step = db; step > da; step--) {
+            child = cur;
+            cur = parentToward(landmark, cur);
+        }
+        if (cur == a) return child;
+    }
+    return parentToward(landmark, a);
+}
+
+bool MapDistanceIndex::isExact() const { return exact; }
+int MapDistanceIndex::getIdCount() const { return idCount; }
+int MapDistanceIndex::getLandmarkCount() const { return (int)landmarks.size(); }
+
+size_t MapDistanceIndex::getMemoryBytes() const {
+    return matrix.size() * sizeof(uint16_t) +
+           (offsets.size() + targets.size() + landmarks.size() + landmarkDistance.size() + nearestLandmark.size()) *
+               sizeof(int);
+}
+
+std::ostream& operator<<(std::ostream& os, const MapDistanceIndex& index) {
+    os << "MapDistanceIndex(" << (index.isExact() ? "matrix" : "landmarks") << ", Ids:" << index.getIdCount();
+    if (!index.isExact()) os << ", Landmarks:" << index.getLandmarkCount();
+    os << ", Bytes:" << index.getMemoryBytes() << ")";
+    return os;
+}
@@ -0,0 +1,58 @@
+#ifndef MAP_DISTANCE_INDEX_H
+#define MAP_DISTANCE_INDEX_H
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+class Map;
+
+struct MapDistanceOptions {
+    int matrixLimit = 4096;     // largest id count stored as a full matrix (2 bytes per pair)
+    int landmarks = 16;         // landmarks used above that size
+};
+
+// Hop distances between territories, for planning moves more than one step ahead.
+// Maps up to matrixLimit ids get an exact all-pairs matrix, with one BFS per territory
+// spread over the shared thread pool. Larger maps keep BFS distances from a few
+// landmarks chosen farthest-first: distance() is then an upper bound and nextHop()
+// follows a route through the target's nearest landmark, which is not always shortest.
+// The index copies the adjacency it needs, so it does not depend on the map afterwards.
+class MapDistanceIndex {
+public:
+    explicit MapDistanceIndex(const Map& map, const MapDistanceOptions& options = MapDistanceOptions());
+    MapDistanceIndex(const MapDistanceIndex& other);  // Copy constructor
+    MapDistanceIndex& operator=(const MapDistanceIndex& other);  // Assignment operator
+    ~MapDistanceIndex() {}
+
+    // Hops from a to b, or -1 when either id is unknown or b cannot be reached
+    int distance(int a, int b) const;
+    // Neighbour of a to move to on the way to b, or -1 when a == b or b cannot be reached
+    int nextHop(int a, int b) const;
+
+    bool isExact() const;
+    int getIdCount() const;
+    int getLandmarkCount() const;
+    size_t getMemoryBytes() const;
+
+    friend std::ostream& operator<<(std::ostream& os, const MapDistanceIndex& index);
+
+private:
+    static constexpr uint16_t kFar = 0xFFFF;       // unreachable in the matrix
+
+    int idCount;
+    bool exact;
+    std::vector<int> offsets;                      // CSR adjacency copied from the map
+    std::vector<int> targets;
+    std::vector<uint16_t> matrix;                  // exact mode: idCount x idCount
+    std::vector<int> landmarks;                    // landmark mode
+    std::vector<int> landmarkDistance;             // [landmark][id], -1 unreachable
+    std::vector<int> nearestLandmark;              // per id, index into landmarks
+
+    void buildMatrix(const std::vector<int>& territoryIds);
+    void buildLandmarks(const std::vector<int>& territoryIds, int count);
+    int landmarkDistanceOf(int landmark, int id) const;
+    int parentToward(int landmark, int id) const;
+};
+
+#endif
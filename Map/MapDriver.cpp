@@ -1,6 +1,15 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include <vector>
 #include "Map.h" 
+#include "MapDistanceIndex.h"
+#include "MapPartition.h"
 
 // Test function demonstrating Map validation and functionality
 void testLoadMaps() {
@@ -27,9 +36,392 @@ void testLoadMaps() {
     }
 }
 
+// Batch version of testLoadMaps: the same files loaded concurrently, one report each
+void testBatchLoadMaps() {
+    MapLoader loader(MapLoadMode::Mapped);
+    std::vector<MapLoadResult> results = loader.loadBatch({
+        "Map/Asia.map",
+        "Map/Europe.map",
+        "Map/Invalid.map",
+        "Map/canada.map",
+        "Map/Missing.map"
+    });
+
+    for (const MapLoadResult& result : results) {
+        std::cout << "Batch " << result.file << ": " << (result.valid ? "valid" : "invalid") << ", "
+                  << result.territories << " territories, " << result.continents << " continents";
+        if (!result.valid) std::cout << " (" << result.reason << ")";
+        std::cout << std::endl;
+    }
+}
+
+// Compiles each map to .wzmap, reloads it and checks it matches the text map
+void testCompiledMapRoundTrip() {
+    MapLoader loader;
+
+    std::vector<std::string> testFiles = {
+        "Map/Asia.map",
+        "Map/Europe.map",
+        "Map/canada.map"
+    };
+
+    for (const auto& file : testFiles) {
+        std::string compiled = file.substr(0, file.rfind('.')) + ".wzmap";
+        Map* text = loader.loadMap(file);
+        Map* binary = loader.compile(file, compiled) ? loader.loadMap(compiled) : nullptr;
+        std::remove(compiled.c_str());
+        if (!text || !binary) {
+            std::cout << "Round trip " << file << ": could not load" << std::endl;
+            delete text;
+            delete binary;
+            continue;
+        }
+
+        bool same = text->getContinents().size() == binary->getContinents().size() &&
+                    text->getTerritories().size() == binary->getTerritories().size();
+        for (size_t i = 0; same && i < text->getContinents().size(); i++) {
+            Continent* a = text->getContinents()[i];
+            Continent* b = binary->getContinents()[i];
+            same = a->getName() == b->getName() && a->getBonus() == b->getBonus() &&
+                   a->getTerritories().size() == b->getTerritories().size();
+        }
+        for (size_t i = 0; same && i < text->getTerritories().size(); i++) {
+            Territory* a = text->getTerritories()[i];
+            Territory* b = binary->getTerritories()[i];
+            std::vector<int> aIds, bIds;
+            for (Territory* n : a->getAdjacents()) aIds.push_back(n->getId());
+            for (Territory* n : b->getAdjacents()) bIds.push_back(n->getId());
+            std::sort(aIds.begin(), aIds.end());
+            std::sort(bIds.begin(), bIds.end());
+            same = a->getId() == b->getId() && a->getName() == b->getName() &&
+                   a->getX() == b->getX() && a->getY() == b->getY() &&
+                   a->getContinent()->getName() == b->getContinent()->getName() &&
+                   aIds == bIds && binary->getTerritoryByName(a->getName()) == b;
+        }
+
+        std::cout << "Round trip " << file << ": " << (same ? "identical" : "MISMATCH") << std::endl;
+        delete text;
+        delete binary;
+    }
+}
+
+// Checks the distance index against a plain BFS over getAdjacents(), and that routes
+// built from nextHop() reach their target in both the matrix and the landmark layout
+void testMapDistanceIndex() {
+    MapLoader loader;
+    Map* map = loader.loadMap("Map/canada.map");
+    if (!map) {
+        std::cout << "Distance index: could not load Map/canada.map" << std::endl;
+        return;
+    }
+
+    const std::vector<Territory*>& territories = map->getTerritories();
+    MapDistanceOptions landmarkOptions;
+    landmarkOptions.matrixLimit = 0;
+    landmarkOptions.landmarks = 4;
+    const MapDistanceIndex& exact = map->getDistanceIndex();
+    const MapDistanceIndex approximate(*map, landmarkOptions);
+    const std::vector<int>& offsets = map->getAdjacencyOffsets();
+    const std::vector<int>& targets = map->getAdjacencyTargets();
+
+    int wrong = 0;
+    int brokenRoutes = 0;
+    int underestimates = 0;
+    for (Territory* source : territories) {
+        std::vector<int> hops(offsets.size(), -1);
+        std::vector<Territory*> frontier = {source};
+        hops[source->getId()] = 0;
+        for (size_t head = 0; head < frontier.size(); head++) {
+            for (Territory* n : frontier[head]->getAdjacents()) {
+                if (hops[n->getId()] >= 0) continue;
+                hops[n->getId()] = hops[frontier[head]->getId()] + 1;
+                frontier.push_back(n);
+            }
+        }
+
+        for (Territory* target : territories) {
+            int a = source->getId();
+            int b = target->getId();
+            if (exact.distance(a, b) != hops[b]) wrong++;
+            if (approximate.distance(a, b) < hops[b]) underestimates++;
+
+            for (const MapDistanceIndex* index : {&exact, &approximate}) {
+                int at = a;
+                int steps = 0;
+                while (at != b && at >= 0 && steps <= (int)territories.size()) {
+                    int next = index->nextHop(at, b);
+                    if (next < 0 || std::find(targets.begin() + offsets[at], targets.begin() + offsets[at + 1], next) == targets.begin() + offsets[at + 1]) {
+                        at = -1;
+                        break;
+                    }
+                    at = next;
+                    steps++;
+                }
+                if (at != b || (index == &exact && steps != hops[b])) brokenRoutes++;
+            }
+        }
+    }
+
+    std::cout << exact << ": " << (wrong == 0 ? "matches BFS" : "MISMATCH") << std::endl;
+    std::cout << approximate << ": " << (underestimates == 0 ? "upper bounds" : "UNDERESTIMATES")
+              << ", routes " << (brokenRoutes == 0 ? "reach every target" : "BROKEN") << std::endl;
+    delete map;
+}
+
+// Checks that a partition covers every territory once, stays within the size limit,
+// and that its boundary lists and cut count agree with the adjacency. Its cut is
+// compared against using the continents themselves as regions
+void testMapPartition() {
+    MapLoader loader;
+    Map* map = loader.loadMap("Map/canada.map");
+    if (!map) {
+        std::cout << "Partition: could not load Map/canada.map" << std::endl;
+        return;
+    }
+
+    const std::vector<Territory*>& territories = map->getTerritories();
+    const std::vector<int>& offsets = map->getAdjacencyOffsets();
+    const std::vector<int>& targets = map->getAdjacencyTargets();
+    int continentCut = 0;
+    for (Territory* t : territories) {
+        for (Territory* n : t->getAdjacents()) {
+            if (n->getId() > t->getId() && n->getContinent() != t->getContinent()) continentCut++;
+        }
+    }
+
+    for (int regions : {2, 4, 8}) {
+        MapPartitionOptions options;
+        options.regions = regions;
+        MapPartition partition(*map, options);
+        int limit = (int)((territories.size() + regions - 1) / regions * (1.0 + options.imbalance)) + 1;
+
+        int problems = 0;
+        int cut = 0;
+        size_t covered = 0;
+        for (int r = 0; r < partition.getRegionCount(); r++) {
+            covered += partition.getTerritories(r).size();
+            if ((int)partition.getTerritories(r).size() > limit) problems++;
+        }
+        if (covered != territories.size()) problems++;
+        for (Territory* t : territories) {
+            int id = t->getId();
+            bool crosses = false;
+            for (int i = offsets[id]; i < offsets[id + 1]; i++) {
+                int other = targets[i];
+                if (partition.getCommonRegion(id, other) >= 0) continue;
+                crosses = true;
+                if (other > id) cut++;
+            }
+            if (crosses != partition.isBoundary(id)) problems++;
+        }
+        if (cut != partition.getCutEdges()) problems++;
+
+        std::cout << partition << " vs " << continentCut << " between continents: "
+                  << (problems == 0 ? "consistent" : "INCONSISTENT") << std::endl;
+    }
+    delete map;
+}
+
+namespace {
+    // Continents, territories and edges by name, sorted, so maps with different ids compare equal
+    std::vector<std::string> describeMap(const Map& map) {
+        std::vector<std::string> lines;
+        for (Continent* c : map.getContinents()) {
+            lines.push_back("C " + std::string(c->getName()) + "=" + std::to_string(c->getBonus()));
+        }
+        for (Territory* t : map.getTerritories()) {
+            std::ostringstream line;
+            line << "T " << t->getName() << "," << t->getX() << "," << t->getY() << "," << t->getContinent()->getName();
+            lines.push_back(line.str());
+            for (Territory* n : t->getAdjacents()) {
+                if (t->getName() < n->getName()) lines.push_back("E " + std::string(t->getName()) + "-" + std::string(n->getName()));
+            }
+        }
+        std::sort(lines.begin(), lines.end());
+        return lines;
+    }
+
+    // Rewrites a map file line by line; edit returns false to drop the line
+    template <typename Edit>
+    void writeEdited(const std::vector<std::string>& source, const std::string& target, Edit edit) {
+        std::ofstream out(target);
+        for (std::string line : source) {
+            if (edit(line)) out << line << "\n";
+        }
+    }
+}
+
+// Edits a copy of canada.map step by step and reloads it incrementally, checking each
+// result against a fresh load of the same file and the full validation checks
+void testMapReload() {
+    std::vector<std::string> source;
+    std::ifstream in("Map/canada.map");
+    for (std::string line; std::getline(in, line);) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        source.push_back(line);
+    }
+    const std::string file = "reload_test.map";
+    writeEdited(source, file, [](std::string&) { return true; });
+
+    MapLoader loader(MapLoadMode::Mapped);
+    Map* map = loader.loadMap(file);
+    if (!map) {
+        std::cout << "Reload: could not load " << file << std::endl;
+        return;
+    }
+    const int firstId = map->getTerritoryByName("1")->getId();
+
+    struct Step {
+        const char* label;
+        std::function<bool(std::string&)> edit;
+    };
+    std::vector<Step> steps = {
+        {"move and rebalance", [](std::string& line) {
+            if (line == "Yukon=6") line = "Yukon=7";
+            if (line.rfind("43,", 0) == 0) line = "43,580,380,Northwest Territories,41";
+            return true;
+        }},
+        {"add continent", [](std::string& line) {
+            if (line == "Yukon=6") line = "Yukon=7";
+            if (line == "New Brunswick=2") line += "\nHudson=3";
+            if (line.rfind("43,", 0) == 0) line = "43,580,380,Northwest Territories,41\nBelcher,600,400,Hudson,43";
+            return true;
+        }},
+        {"cut off territory 43", [](std::string& line) {
+            if (line == "Yukon=6") line = "Yukon=7";
+            if (line == "New Brunswick=2") line += "\nHudson=3";
+            if (line.rfind("43,", 0) == 0) line = "Belcher,600,400,Hudson";
+            if (line.rfind("41,", 0) == 0) line = "41,514,368,Northwest Territories,40,42";
+            return true;
+        }},
+        {"restore", [](std::string&) { return true; }},
+    };
+
+    for (const Step& step : steps) {
+        writeEdited(source, file, step.edit);
+        MapDiff diff;
+        bool valid = loader.reload(*map, file, &diff);
+
+        MapValidationReport full;
+        bool fullValid = map->validate(&full, true);
+        MapLoader freshLoader(MapLoadMode::Mapped);
+        freshLoader.setQuiet(true);
+        Map* fresh = freshLoader.loadMap(file);
+        bool matches = valid == fullValid && valid == (fresh != nullptr) && (!fresh || describeMap(*fresh) == describeMap(*map));
+        bool idsKept = map->getTerritoryByName("1")->getId() == firstId;
+
+        std::cout << "Reload " << step.label << ": " << diff << " -> " << (valid ? "valid" : "invalid") << ", "
+                  << (matches ? "matches a fresh load" : "DIFFERS from a fresh load")
+                  << (idsKept ? "" : ", ids renumbered") << std::endl;
+        delete fresh;
+    }
+    delete map;
+    std::remove(file.c_str());
+}
+
+namespace {
+    // Average id distance across the adjacency table; smaller means neighbours sit closer in memory
+    double meanIdGap(const Map& map) {
+        const std::vector<int>& offsets = map.getAdjacencyOffsets();
+        const std::vector<int>& targets = map.getAdjacencyTargets();
+        double total = 0.0;
+        for (int id = 0; id + 1 < (int)offsets.size(); id++) {
+            for (int i = offsets[id]; i < offsets[id + 1]; i++) total += std::abs(targets[i] - id);
+        }
+        return targets.empty() ? 0.0 : total / targets.size();
+    }
+}
+
+// Renumbers a copy of each bundled map and checks that it is the same map under new ids:
+// same names, edges and continents, lookups and state moved with the ids, and the
+// original map, which shared its topology with the copy, left untouched
+void testMapRenumbering() {
+    MapLoader loader;
+    for (const std::string file : {"Map/Asia.map", "Map/Europe.map", "Map/canada.map"}) {
+        Map* map = loader.loadMap(file);
+        if (!map) {
+            std::cout << "Renumber: could not load " << file << std::endl;
+            continue;
+        }
+        const std::vector<std::string> before = describeMap(*map);
+        std::cout << "Renumber " << file << ": file gap " << meanIdGap(*map);
+
+        for (MapOrdering ordering : {MapOrdering::Bfs, MapOrdering::ReverseCuthillMcKee}) {
+            Map copy(*map);
+            for (Territory* t : copy.getTerritories()) t->setArmies((int)t->getName().size() + t->getX());
+            copy.renumber(ordering);
+
+            int problems = describeMap(copy) == before ? 0 : 1;
+            const std::vector<Territory*>& territories = copy.getTerritories();
+            for (size_t i = 0; i < territories.size(); i++) {
+                Territory* t = territories[i];
+                if (copy.getTerritory(t->getId()) != t || copy.getTerritoryByName(t->getName()) != t) problems++;
+                if (i > 0 && territories[i - 1]->getId() >= t->getId()) problems++;
+                if (t->getArmies() != (int)t->getName().size() + t->getX()) problems++;
+                if (copy.getState().getContinentOf(t->getId()) != copy.getContinentIndex(t->getContinent())) problems++;
+            }
+            if (!copy.validate(nullptr, true)) problems++;
+
+            // A loader set to the same order hands back the same ids
+            MapLoader orderedLoader;
+            orderedLoader.setOrdering(ordering);
+            Map* ordered = orderedLoader.loadMap(file);
+            if (!ordered || ordered->getAdjacencyTargets() != copy.getAdjacencyTargets() ||
+                ordered->getTerritory(0)->getName() != copy.getTerritory(0)->getName()) {
+                problems++;
+            }
+            delete ordered;
+
+            std::cout << ", " << (ordering == MapOrdering::Bfs ? "bfs" : "rcm") << " gap " << meanIdGap(copy)
+                      << (problems == 0 ? "" : " (INCONSISTENT)");
+        }
+        std::cout << (describeMap(*map) == before ? ", original unchanged" : ", ORIGINAL CHANGED") << std::endl;
+        delete map;
+    }
+}
+
+// Feeds the same malformed or unusual numbers to both text loaders, as a continent bonus
+// and as a coordinate. The mapped loader must accept exactly what std::stoi accepts.
+void testMalformedNumbers() {
+    const std::string file = "malformed_test.map";
+    const std::vector<std::string> values = {"+-5", "-+5", "++5", "+", "-", "+ 5", "x5", "+5", "-5", "5abc", "99999999999"};
+    int disagreements = 0;
+    std::ostringstream verdicts;
+    for (const std::string& value : values) {
+        for (bool asBonus : {true, false}) {
+            {
+                std::ofstream out(file);
+                out << "[Continents]\nNorth=" << (asBonus ? value : "3") << "\n\n[Territories]\n"
+                    << "A," << (asBonus ? "10" : value) << ",10,North,B\nB,20,20,North,A\n";
+            }
+            bool accepted[2];
+            int mode = 0;
+            for (MapLoadMode loadMode : {MapLoadMode::Stream, MapLoadMode::Mapped}) {
+                MapLoader loader(loadMode);
+                loader.setQuiet(true);
+                Map* map = loader.loadMap(file);
+                accepted[mode++] = map != nullptr;
+                delete map;
+            }
+            if (accepted[0] != accepted[1]) disagreements++;
+            if (asBonus) verdicts << " \"" << value << "\" " << (accepted[0] ? "accepted" : "rejected") << (accepted[0] == accepted[1] ? "" : " (MISMATCH)");
+        }
+    }
+    std::remove(file.c_str());
+    std::cout << "Malformed numbers:" << verdicts.str() << "; stream and mapped loaders "
+              << (disagreements == 0 ? "agree" : "DISAGREE") << std::endl;
+}
+
 #ifndef MAIN_DRIVER_INCLUDED
 int main() {
     testLoadMaps();
+    testBatchLoadMaps();
+    testMalformedNumbers();
+    testCompiledMapRoundTrip();
+    testMapDistanceIndex();
+    testMapPartition();
+    testMapReload();
+    testMapRenumbering();
     return 0;
 }
 #endif
@@ -0,0 +1,259 @@
+#include "MapGenerator.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <random>
+
+namespace {
+    // std::mt19937_64 output is fixed by the standard, unlike the std distributions,
+    // so ranges are reduced by hand to keep files identical across compilers
+    class GeneratorRng {
+    public:
+        explicit GeneratorRng(uint64_t seed) : engine(seed) {}
+        uint64_t below(uint64_t n) { return n ? engine() % n : 0; }
+        double unit() { return (engine() >> 11) * (1.0 / 9007199254740992.0); }
+
+    private:
+        std::mt19937_64 engine;
+    };
+
+    // Square-ish lattice walked in serpentine order, so consecutive ids are always
+    // neighbours and any run of ids (a continent) is connected by the path alone
+    struct Serpentine {
+        int count;
+        int width;
+        int rows;
+
+        explicit Serpentine(int count) : count(count), width(1), rows(1) {
+            while ((int64_t)width * width < count) width++;
+            rows = (count + width - 1) / width;
+        }
+
+        int idAt(int row, int col) const {
+            if (row < 0 || row >= rows || col < 0 || col >= width) return -1;
+            int id = row * width + (row % 2 == 0 ? col : width - 1 - col);
+            return id < count ? id : -1;
+        }
+        int rowOf(int id) const { return id / width; }
+        int colOf(int id) const {
+            int row = id / width;
+            return row % 2 == 0 ? id % width : width - 1 - id % width;
+        }
+    };
+
+    void appendInt(std::string& out, long long value) {
+        char buffer[24];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out.append(buffer, result.ptr);
+    }
+}
+
+MapGenerator::MapGenerator() : edgeCount(0) {}
+
+MapGenerator::MapGenerator(const MapGeneratorOptions& options) : options(options), edgeCount(0) {}
+
+// Copy constructor
+MapGenerator::MapGenerator(const MapGenerator& other) : options(other.options), edgeCount(other.edgeCount) {}
+
+// Assignment operator
+MapGenerator& MapGenerator::operator=(const MapGenerator& other) {
+    if (this != &other) {
+        options = other.options;
+        edgeCount = other.edgeCount;
+    }
+    return *this;
+}
+
+const MapGeneratorOptions& MapGenerator::getOptions() const { return options; }
+void MapGenerator::setOptions(const MapGeneratorOptions& o) { options = o; }
+size_t MapGenerator::getEdgeCount() const { return edgeCount; }
+
+// Continents are balanced runs of consecutive ids
+int MapGenerator::continentOf(int territory) const {
+    return (int)((int64_t)territory * options.continents / options.territories);
+}
+
+// Fills edges with a spanning path or tree plus randomly chosen extra edges up to the
+// requested average degree, and coordinates with x, y pairs
+void MapGenerator::generateEdges(std::vector<std::pair<int, int>>& edges, std::vector<int>& coordinates) const {
+    const int n = options.territories;
+    GeneratorRng rng(options.seed);
+    int64_t targetEdges = std::llround(n * std::max(0.0, options.averageDegree) / 2.0);
+    int64_t extraEdges = std::max<int64_t>(0, targetEdges - (n - 1));
+
+    edges.clear();
+    coordinates.assign(2 * (size_t)n, 0);
+
+    if (options.topology == GeneratedTopology::Random) {
+        Serpentine layout(n);
+        for (int i = 0; i < n; i++) {
+            coordinates[2 * i] = (int)rng.below(layout.width * 10);
+            coordinates[2 * i + 1] = (int)rng.below(layout.rows * 10);
+        }
+
+        // Random recursive tree: each territory hangs off an earlier one in its own
+        // continent, and each continent's first territory off any earlier territory
+        edges.reserve(n - 1 + extraEdges);
+        int continentStart = 0;
+        for (int i = 1; i < n; i++) {
+            if (continentOf(i) != continentOf(i - 1)) continentStart = i;
+            int parent = (i > continentStart) ? continentStart + (int)rng.below(i - continentStart) : (int)rng.below(i);
+            edges.push_back({parent, i});
+        }
+
+        // Extra edges stay inside the continent nine times out of ten
+        for (int64_t e = 0; e < extraEdges && n > 1; e++) {
+            int u = (int)rng.below(n);
+            int c = continentOf(u);
+            int first = (int)(((int64_t)c * n + options.continents - 1) / options.continents);
+            int last = (int)(((int64_t)(c + 1) * n + options.continents - 1) / options.continents);
+            int v = (rng.unit() < 0.9 && last - first > 1) ? first + (int)rng.below(last - first) : (int)rng.below(n);
+            if (u != v) edges.push_back({std::min(u, v), std::max(u, v)});
+        }
+    } else {
+        Serpentine layout(n);
+        bool planar = options.topology == GeneratedTopology::Planar;
+        for (int i = 0; i < n; i++) {
+            int jitterX = planar ? (int)rng.below(5) : 0;
+            int jitterY = planar ? (int)rng.below(5) : 0;
+            coordinates[2 * i] = layout.colOf(i) * 10 + jitterX;
+            coordinates[2 * i + 1] = layout.rowOf(i) * 10 + jitterY;
+        }
+
+        edges.reserve(n - 1 + extraEdges);
+        for (int i = 1; i < n; i++) edges.push_back({i - 1, i});
+
+        // Lattice edges not on the path. Grid only needs diagonals above degree 4 and
+        // then takes both; planar takes one diagonal per cell so no two edges cross
+        std::vector<std::pair<int, int>> candidates;
+        bool diagonals = planar || options.averageDegree > 4.0;
+        for (int i = 0; i < n; i++) {
+            int row = layout.rowOf(i);
+            int col = layout.colOf(i);
+            int down = layout.idAt(row + 1, col);
+            if (down >= 0 && down != i + 1 && down != i - 1) candidates.push_back({i, down});
+            if (!diagonals) continue;
+            int right = layout.idAt(row, col + 1);
+            int downRight = layout.idAt(row + 1, col + 1);
+            if (planar) {
+                if (right < 0 || down < 0 || downRight < 0) continue;
+                if (rng.below(2)) candidates.push_back({i, downRight});
+                else candidates.push_back({std::min(right, down), std::max(right, down)});
+            } else {
+                int downLeft = layout.idAt(row + 1, col - 1);
+                if (downRight >= 0) candidates.push_back({i, downRight});
+                if (downLeft >= 0) candidates.push_back({i, downLeft});
+            }
+        }
+
+        // Partial Fisher-Yates: pick exactly the extra edges needed, or all candidates
+        int64_t picks = std::min<int64_t>(extraEdges, candidates.size());
+        for (int64_t k = 0; k < picks; k++) {
+            size_t j = k + rng.below(candidates.size() - k);
+            std::swap(candidates[k], candidates[j]);
+            edges.push_back(candidates[k]);
+        }
+    }
+
+    // Random extra edges may repeat
+    for (auto& e : edges) {
+        if (e.first > e.second) std::swap(e.first, e.second);
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+}
+
+bool MapGenerator::write(const std::string& filename) {
+    options.territories = std::max(1, options.territories);
+    options.continents = std::min(std::max(1, options.continents), options.territories);
+    const int n = options.territories;
+
+    std::vector<std::pair<int, int>> edges;
+    std::vector<int> coordinates;
+    generateEdges(edges, coordinates);
+    edgeCount = edges.size();
+
+    // Adjacency lists in CSR form, both directions, for the per-territory lines
+    std::vector<int> offsets(n + 1, 0);
+    for (const auto& e : edges) {
+        offsets[e.first + 1]++;
+        offsets[e.second + 1]++;
+    }
+    for (int i = 0; i < n; i++) offsets[i + 1] += offsets[i];
+    std::vector<int> targets(offsets[n]);
+    std::vector<int> cursor(offsets.begin(), offsets.end() - 1);
+    for (const auto& e : edges) {
+        targets[cursor[e.first]++] = e.second;
+        targets[cursor[e.second]++] = e.first;
+    }
+    std::vector<std::pair<int, int>>().swap(edges);
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+
+    std::string buffer;
+    buffer.reserve(1 << 20);
+    auto flush = [&](bool force) {
+        if (force || buffer.size() >= (1 << 20) - 4096) {
+            out.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    };
+
+    buffer += "[Map]\nauthor=MapGenerator\nimage=none\nwrap=no\nscroll=none\nwarn=no\n\n[Continents]\n";
+    for (int c = 0; c < options.continents; c++) {
+        int first = (int)(((int64_t)c * n + options.continents - 1) / options.continents);
+        int last = (int)(((int64_t)(c + 1) * n + options.continents - 1) / options.continents);
+        buffer += "Continent ";
+        appendInt(buffer, c);
+        buffer += '=';
+        appendInt(buffer, std::min(10, 2 + (last - first) / 8));
+        buffer += '\n';
+        flush(false);
+    }
+
+    buffer += "\n[Territories]\n";
+    for (int i = 0; i < n; i++) {
+        buffer += "Territory ";
+        appendInt(buffer, i);
+        buffer += ',';
+        appendInt(buffer, coordinates[2 * i]);
+        buffer += ',';
+        appendInt(buffer, coordinates[2 * i + 1]);
+        buffer += ",Continent ";
+        appendInt(buffer, continentOf(i));
+        for (int k = offsets[i]; k < offsets[i + 1]; k++) {
+            buffer += ",Territory ";
+            appendInt(buffer, targets[k]);
+        }
+        buffer += '\n';
+        flush(false);
+    }
+    flush(true);
+    return (bool)out;
+}
+
+bool MapGenerator::parseTopology(const std::string& name, GeneratedTopology& topology) {
+    if (name == "grid") topology = GeneratedTopology::Grid;
+    else if (name == "planar") topology = GeneratedTopology::Planar;
+    else if (name == "random") topology = GeneratedTopology::Random;
+    else return false;
+    return true;
+}
+
+std::string MapGenerator::topologyName(GeneratedTopology topology) {
+    switch (topology) {
+        case GeneratedTopology::Grid: return "grid";
+        case GeneratedTopology::Planar: return "planar";
+        case GeneratedTopology::Random: return "random";
+    }
+    return "unknown";
+}
+
+std::ostream& operator<<(std::ostream& os, const MapGenerator& generator) {
+    const MapGeneratorOptions& o = generator.getOptions();
+    os << "MapGenerator(" << MapGenerator::topologyName(o.topology) << ", Territories:" << o.territories
+       << ", Continents:" << o.continents << ", Degree:" << o.averageDegree << ", Seed:" << o.seed << ")";
+    return os;
+}
@@ -0,0 +1,57 @@
+#ifndef MAP_GENERATOR_H
+#define MAP_GENERATOR_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Shape of the generated adjacency graph
+enum class GeneratedTopology {
+    Grid,       // square lattice, diagonals added above degree 4
+    Planar,     // jittered lattice triangulated cell by cell, degree up to ~6
+    Random      // random tree plus random extra edges, mostly inside continents
+};
+
+struct MapGeneratorOptions {
+    int territories = 1000;
+    int continents = 10;
+    double averageDegree = 4.0;
+    GeneratedTopology topology = GeneratedTopology::Grid;
+    uint64_t seed = 345;
+};
+
+// Writes valid Conquest-format .map files for scale testing. Every territory belongs
+// to exactly one continent, each continent is connected and so is the whole map.
+// Output depends only on the options, so the same seed gives the same file everywhere.
+class MapGenerator {
+public:
+    MapGenerator();
+    explicit MapGenerator(const MapGeneratorOptions& options);
+    MapGenerator(const MapGenerator& other);  // Copy constructor
+    MapGenerator& operator=(const MapGenerator& other);  // Assignment operator
+    ~MapGenerator() {}
+
+    const MapGeneratorOptions& getOptions() const;
+    void setOptions(const MapGeneratorOptions& options);
+
+    // Generate and write the map; returns false if the file could not be written
+    bool write(const std::string& filename);
+    // Undirected edges written by the last write() call
+    size_t getEdgeCount() const;
+
+    static bool parseTopology(const std::string& name, GeneratedTopology& topology);
+    static std::string topologyName(GeneratedTopology topology);
+
+    friend std::ostream& operator<<(std::ostream& os, const MapGenerator& generator);
+
+private:
+    MapGeneratorOptions options;
+    size_t edgeCount;
+
+    void generateEdges(std::vector<std::pair<int, int>>& edges, std::vector<int>& coordinates) const;
+    int continentOf(int territory) const;
+};
+
+#endif
@@ -0,0 +1,73 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "Map.h"
+#include "MapGenerator.h"
+
+namespace {
+    void printUsage() {
+        std::cout << "Usage: MapGenerator <output.map> [--territories N] [--continents N] [--degree D]\n"
+                  << "                    [--topology grid|planar|random] [--seed S] [--validate]" << std::endl;
+    }
+}
+
+// Generates one map from the command line and optionally loads and validates it
+int runMapGenerator(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    std::string output = argv[1];
+    MapGeneratorOptions options;
+    bool validate = false;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--validate") {
+            validate = true;
+        } else if (arg == "--territories" && hasValue) {
+            options.territories = std::atoi(argv[++i]);
+        } else if (arg == "--continents" && hasValue) {
+            options.continents = std::atoi(argv[++i]);
+        } else if (arg == "--degree" && hasValue) {
+            options.averageDegree = std::atof(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--topology" && hasValue && MapGenerator::parseTopology(argv[i + 1], options.topology)) {
+            i++;
+        } else {
+            std::cout << "Unknown or incomplete option: " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    MapGenerator generator(options);
+    auto start = std::chrono::steady_clock::now();
+    if (!generator.write(output)) {
+        std::cout << "Error: Could not write " << output << std::endl;
+        return 1;
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << generator << " -> " << output << ": " << generator.getEdgeCount() << " edges, average degree "
+              << 2.0 * generator.getEdgeCount() / generator.getOptions().territories << ", " << ms << " ms" << std::endl;
+
+    if (validate) {
+        MapLoader loader(MapLoadMode::Mapped);
+        Map* map = loader.loadMap(output);
+        if (!map) return 1;
+        MapValidationReport report;
+        map->validate(&report);
+        std::cout << report << std::endl;
+        delete map;
+    }
+    return 0;
+}
+
+#ifndef MAIN_DRIVER_INCLUDED
+int main(int argc, char* argv[]) {
+    return runMapGenerator(argc, argv);
+}
+#endif
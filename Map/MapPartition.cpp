@@ -0,0 +1,434 @@
+#include "MapPartition.h"
+#include "Map.h"
+#include "../ThreadPool/ThreadPool.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <utility>
+
+namespace {
+    const int kPending = -2;
+
+    // BFS scratch shared by every split; visited marks are stamps so nothing is cleared between runs
+    struct SplitScratch {
+        std::vector<int> stamp;
+        std::vector<int> frontier;
+        int current = 0;
+    };
+
+    // Relabels members (all carrying the same label) into pieces of near-equal size.
+    // Each piece is grown by BFS from the far end of what is left of the group, so the
+    // pieces come out as compact slices; the first keeps the old label and the others
+    // take labels from nextLabel upwards
+    void splitGroup(const std::vector<int>& offsets, const std::vector<int>& targets, std::vector<int>& label,
+                    const std::vector<int>& members, int pieces, int& nextLabel, SplitScratch& scratch) {
+        if (members.empty()) return;
+        int from = label[members[0]];
+        for (int id : members) label[id] = kPending;
+        std::vector<int>& frontier = scratch.frontier;
+        size_t remaining = members.size();
+        size_t cursor = 0;
+        for (int p = 0; p < pieces && remaining > 0; p++) {
+            int piece = p == 0 ? from : nextLabel++;
+            size_t quota = (remaining + pieces - p - 1) / (pieces - p);
+            while (quota > 0) {
+                while (label[members[cursor]] != kPending) cursor++;
+                scratch.current++;
+                frontier.assign(1, members[cursor]);
+                scratch.stamp[members[cursor]] = scratch.current;
+                for (size_t head = 0; head < frontier.size(); head++) {
+                    int cur = frontier[head];
+                    for (int i = offsets[cur]; i < offsets[cur + 1]; i++) {
+                        int n = targets[i];
+                        if (label[n] != kPending || scratch.stamp[n] == scratch.current) continue;
+                        scratch.stamp[n] = scratch.current;
+                        frontier.push_back(n);
+                    }
+                }
+
+                int start = frontier.back();
+                frontier.assign(1, start);
+                label[start] = piece;
+                quota--;
+                remaining--;
+                for (size_t head = 0; head < frontier.size() && quota > 0; head++) {
+                    int cur = frontier[head];
+                    for (int i = offsets[cur]; i < offsets[cur + 1] && quota > 0; i++) {
+                        int n = targets[i];
+                        if (label[n] != kPending) continue;
+                        label[n] = piece;
+                        frontier.push_back(n);
+                        quota--;
+                        remaining--;
+                    }
+                }
+            }
+        }
+    }
+
+    // Territory ids of every label, in id order
+    std::vector<std::vector<int>> groupByLabel(const std::vector<int>& label, const std::vector<int>& territoryIds,
+                                               int labels) {
+        std::vector<std::vector<int>> groups(labels);
+        for (int id : territoryIds) groups[label[id]].push_back(id);
+        return groups;
+    }
+}
+
+MapPartition::MapPartition(const Map& map, const MapPartitionOptions& options) : cutEdges(0) {
+    std::vector<int> territoryIds;
+    int idCount = 0;
+    for (int id : map.topology->territoryIds) {
+        if (id < 0) continue;
+        territoryIds.push_back(id);
+        idCount = std::max(idCount, id + 1);
+    }
+    std::vector<int> offsets(idCount + 1, 0);
+    std::vector<int> targets;
+    if (map.hasAdjacency()) {
+        offsets = map.getAdjacencyOffsets();
+        targets = map.getAdjacencyTargets();
+        idCount = (int)offsets.size() - 1;
+    }
+    regionOf.assign(idCount, -1);
+    const int n = (int)territoryIds.size();
+    if (n == 0) {
+        finish(offsets, targets);
+        return;
+    }
+
+    int requested = options.regions > 0 ? options.regions : (int)ThreadPool::shared().size() + 1;
+    const int k = std::min(requested, n);
+    const double share = (double)n / k;
+    const double imbalance = std::max(0.0, options.imbalance);
+    const int maxSize = std::max(1, (int)std::ceil(share * (1.0 + imbalance)));
+    const int minSize = std::max(1, (int)std::floor(share * (1.0 - std::min(imbalance, 1.0))));
+    SplitScratch scratch;
+    scratch.stamp.assign(idCount, 0);
+
+    // Units: one per continent (territories without one share a unit), with continents
+    // over the size limit split into pieces of about one share each
+    const TerritoryState& state = map.getState();
+    const int continentCount = state.getContinentCount();
+    std::vector<int> unit(idCount, -1);
+    for (int id : territoryIds) {
+        int c = state.getContinentOf(id);
+        unit[id] = c >= 0 && c < continentCount ? c : continentCount;
+    }
+    int units = continentCount + 1;
+    std::vector<std::vector<int>> unitMembers = groupByLabel(unit, territoryIds, units);
+    for (const std::vector<int>& members : unitMembers) {
+        if ((int)members.size() > maxSize) {
+            splitGroup(offsets, targets, unit, members, (int)std::ceil(members.size() / share), units, scratch);
+        }
+    }
+    std::vector<int> unitSize(units, 0);
+    for (int id : territoryIds) unitSize[unit[id]]++;
+
+    // Edge counts between units, as (neighbour, weight) lists
+    std::vector<std::pair<int, int>> crossing;
+    for (int id : territoryIds) {
+        for (int i = offsets[id]; i < offsets[id + 1]; i++) {
+            if (unit[targets[i]] != unit[id]) crossing.push_back({unit[id], unit[targets[i]]});
+        }
+    }
+    std::sort(crossing.begin(), crossing.end());
+    std::vector<std::vector<std::pair<int, int>>> unitLinks(units);
+    for (size_t i = 0; i < crossing.size();) {
+        size_t j = i;
+        while (j < crossing.size() && crossing[j] == crossing[i]) j++;
+        unitLinks[crossing[i].first].push_back({crossing[i].second, (int)(j - i)});
+        i = j;
+    }
+
+    // Grow regions from the largest free unit, each time absorbing the neighbouring unit
+    // that shares the most edges with the region, until the region holds one share.
+    // When no whole neighbour fits, the rest of the share is carved off the best-linked
+    // one by BFS from its territories along the region's edge
+    unitMembers = groupByLabel(unit, territoryIds, units);
+    std::vector<int> order;
+    for (int u = 0; u < units; u++) {
+        if (unitSize[u] > 0) order.push_back(u);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return unitSize[a] > unitSize[b]; });
+    std::vector<int> unitRegion(units, -1);
+    std::vector<int> link(units, 0);
+    std::vector<int> regionSize;
+    const int fullShare = std::max(1, (int)std::lround(share));
+    for (int seed : order) {
+        if (unitRegion[seed] >= 0) continue;
+        int r = (int)regionSize.size();
+        regionSize.push_back(0);
+        std::vector<int> touched;
+        auto absorb = [&](int u) {
+            unitRegion[u] = r;
+            regionSize[r] += unitSize[u];
+            for (const auto& l : unitLinks[u]) {
+                if (unitRegion[l.first] >= 0) continue;
+                if (link[l.first] == 0) touched.push_back(l.first);
+                link[l.first] += l.second;
+            }
+        };
+        auto carve = [&](int u, int quota) {
+            std::vector<int> carved;
+            for (int id : unitMembers[u]) {
+                if ((int)carved.size() == quota) break;
+                for (int i = offsets[id]; i < offsets[id + 1]; i++) {
+                    int other = unit[targets[i]];
+                    if (other < 0 || unitRegion[other] != r) continue;
+                    carved.push_back(id);
+                    unit[id] = kPending;
+                    break;
+                }
+            }
+            for (size_t head = 0; head < carved.size() && (int)carved.size() < quota; head++) {
+                int cur = carved[head];
+                for (int i = offsets[cur]; i < offsets[cur + 1] && (int)carved.size() < quota; i++) {
+                    if (unit[targets[i]] != u) continue;
+                    carved.push_back(targets[i]);
+                    unit[targets[i]] = kPending;
+                }
+            }
+
+            int piece = units++;
+            for (int id : carved) unit[id] = piece;
+            std::vector<int>& rest = unitMembers[u];
+            rest.erase(std::remove_if(rest.begin(), rest.end(), [&](int id) { return unit[id] != u; }), rest.end());
+            unitSize[u] = (int)rest.size();
+            unitMembers.push_back(carved);
+            unitSize.push_back((int)carved.size());
+            unitLinks.emplace_back();
+            unitRegion.push_back(r);
+            link.push_back(0);
+            regionSize[r] += (int)carved.size();
+        };
+        absorb(seed);
+        while (regionSize[r] < fullShare) {
+            int best = -1;
+            int nearest = -1;
+            for (int u : touched) {
+                if (unitRegion[u] >= 0) continue;
+                if (nearest < 0 || link[u] > link[nearest]) nearest = u;
+                if (regionSize[r] + unitSize[u] > maxSize) continue;
+                if (best < 0 || link[u] > link[best] || (link[u] == link[best] && unitSize[u] > unitSize[best])) best = u;
+            }
+            if (best >= 0) {
+                absorb(best);
+            } else {
+                if (nearest >= 0) carve(nearest, fullShare - regionSize[r]);
+                break;
+            }
+        }
+        for (int u : touched) link[u] = 0;
+    }
+
+    // Too many regions: fold the smallest into the neighbour it shares most edges with,
+    // preferring neighbours it fits into
+    int regions = (int)regionSize.size();
+    for (int live = regions; live > k; live--) {
+        int smallest = -1;
+        for (int r = 0; r < regions; r++) {
+            if (regionSize[r] > 0 && (smallest < 0 || regionSize[r] < regionSize[smallest])) smallest = r;
+        }
+        std::vector<int> toRegion(regions, 0);
+        for (int u = 0; u < units; u++) {
+            if (unitRegion[u] != smallest) continue;
+            for (const auto& l : unitLinks[u]) {
+                if (unitRegion[l.first] != smallest) toRegion[unitRegion[l.first]] += l.second;
+            }
+        }
+        int target = -1;
+        for (int r = 0; r < regions; r++) {
+            if (r == smallest || regionSize[r] == 0) continue;
+            if (target < 0) {
+                target = r;
+                continue;
+            }
+            bool fits = regionSize[r] + regionSize[smallest] <= maxSize;
+            bool targetFits = regionSize[target] + regionSize[smallest] <= maxSize;
+            if (fits != targetFits) {
+                if (fits) target = r;
+            } else if (toRegion[r] != toRegion[target]) {
+                if (toRegion[r] > toRegion[target]) target = r;
+            } else if (regionSize[r] < regionSize[target]) {
+                target = r;
+            }
+        }
+        for (int u = 0; u < units; u++) {
+            if (unitRegion[u] == smallest) unitRegion[u] = target;
+        }
+        regionSize[target] += regionSize[smallest];
+        regionSize[smallest] = 0;
+    }
+
+    // Compact the region ids and move down to territories
+    std::vector<int> renumber(regions, -1);
+    int live = 0;
+    for (int r = 0; r < regions; r++) {
+        if (regionSize[r] > 0) renumber[r] = live++;
+    }
+    for (int id : territoryIds) regionOf[id] = renumber[unitRegion[unit[id]]];
+    regions = live;
+
+    // Too few regions (continents packed past one share): halve the largest region
+    while (regions < k) {
+        std::vector<std::vector<int>> members = groupByLabel(regionOf, territoryIds, regions);
+        int largest = 0;
+        for (int r = 1; r < regions; r++) {
+            if (members[r].size() > members[largest].size()) largest = r;
+        }
+        if (members[largest].size() < 2) break;
+        splitGroup(offsets, targets, regionOf, members[largest], 2, regions, scratch);
+    }
+
+    // Boundary refinement: move a territory to the neighbouring region holding more of
+    // its neighbours than its own region does, as long as both sizes stay in bounds.
+    // Moves that cut no extra edges are also taken when they even out the sizes, and
+    // any move out of a region over the limit is taken to bring it back under
+    std::vector<int> size(regions, 0);
+    for (int id : territoryIds) size[regionOf[id]]++;
+    std::vector<int> count(regions, 0);
+    std::vector<int> seen;
+    for (int pass = 0; pass < options.refinePasses; pass++) {
+        int moved = 0;
+        for (int id : territoryIds) {
+            int r = regionOf[id];
+            seen.clear();
+            for (int i = offsets[id]; i < offsets[id + 1]; i++) {
+                int s = regionOf[targets[i]];
+                if (count[s]++ == 0) seen.push_back(s);
+            }
+            int best = -1;
+            int bestGain = INT_MIN;
+            for (int s : seen) {
+                if (s == r) continue;
+                int gain = count[s] - count[r];
+                bool allowed;
+                if (size[r] > maxSize) {
+                    allowed = size[s] < maxSize;
+                } else {
+                    allowed = size[s] + 1 <= maxSize && size[r] - 1 >= minSize &&
+                              (gain > 0 || (gain == 0 && size[s] + 1 < size[r]));
+                }
+                if (allowed && (gain > bestGain || (gain == bestGain && size[s] < size[best]))) {
+                    best = s;
+                    bestGain = gain;
+                }
+            }
+            for (int s : seen) count[s] = 0;
+            if (best < 0) continue;
+            regionOf[id] = best;
+            size[r]--;
+            size[best]++;
+            moved++;
+        }
+        if (moved == 0) break;
+    }
+
+    finish(offsets, targets);
+}
+
+// Copy constructor
+MapPartition::MapPartition(const MapPartition& other)
+    : regionOf(other.regionOf), boundary(other.boundary), regionTerritories(other.regionTerritories),
+      regionBoundary(other.regionBoundary), regionNeighbours(other.regionNeighbours), cutEdges(other.cutEdges) {}
+
+// Assignment operator
+MapPartition& MapPartition::operator=(const MapPartition& other) {
+    if (this != &other) {
+        regionOf = other.regionOf;
+        boundary = other.boundary;
+        regionTerritories = other.regionTerritories;
+        regionBoundary = other.regionBoundary;
+        regionNeighbours = other.regionNeighbours;
+        cutEdges = other.cutEdges;
+    }
+    return *this;
+}
+
+// Numbers the regions by their lowest territory id, dropping any left empty, and
+// derives the member, boundary and neighbour lists and the cut size
+void MapPartition::finish(const std::vector<int>& offsets, const std::vector<int>& targets) {
+    const int idCount = (int)regionOf.size();
+    std::vector<int> renumber;
+    for (int id = 0; id < idCount; id++) {
+        int r = regionOf[id];
+        if (r < 0) continue;
+        if (r >= (int)renumber.size()) renumber.resize(r + 1, -1);
+        if (renumber[r] < 0) {
+            renumber[r] = (int)regionTerritories.size();
+            regionTerritories.emplace_back();
+        }
+        regionOf[id] = renumber[r];
+        regionTerritories[regionOf[id]].push_back(id);
+    }
+    const int regions = (int)regionTerritories.size();
+    regionBoundary.assign(regions, std::vector<int>());
+    regionNeighbours.assign(regions, std::vector<int>());
+    boundary.assign(idCount, 0);
+    cutEdges = 0;
+
+    for (int id = 0; id < idCount; id++) {
+        int r = regionOf[id];
+        if (r < 0) continue;
+        for (int i = offsets[id]; i < offsets[id + 1]; i++) {
+            int s = regionOf[targets[i]];
+            if (s == r || s < 0) continue;
+            boundary[id] = 1;
+            regionNeighbours[r].push_back(s);
+            if (targets[i] > id) cutEdges++;
+        }
+        if (boundary[id]) regionBoundary[r].push_back(id);
+    }
+    for (std::vector<int>& neighbours : regionNeighbours) {
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+    }
+}
+
+int MapPartition::getRegionCount() const { return (int)regionTerritories.size(); }
+
+int MapPartition::getRegion(int id) const {
+    return id >= 0 && id < (int)regionOf.size() ? regionOf[id] : -1;
+}
+
+int MapPartition::getCommonRegion(int a, int b) const {
+    int r = getRegion(a);
+    return r >= 0 && r == getRegion(b) ? r : -1;
+}
+
+bool MapPartition::isBoundary(int id) const {
+    return id >= 0 && id < (int)boundary.size() && boundary[id];
+}
+
+namespace {
+    const std::vector<int> kNoIds;
+}
+
+const std::vector<int>& MapPartition::getTerritories(int region) const {
+    return region >= 0 && region < getRegionCount() ? regionTerritories[region] : kNoIds;
+}
+
+const std::vector<int>& MapPartition::getBoundaryTerritories(int region) const {
+    return region >= 0 && region < getRegionCount() ? regionBoundary[region] : kNoIds;
+}
+
+const std::vector<int>& MapPartition::getNeighbourRegions(int region) const {
+    return region >= 0 && region < getRegionCount() ? regionNeighbours[region] : kNoIds;
+}
+
+int MapPartition::getCutEdges() const { return cutEdges; }
+
+int MapPartition::getLargestRegionSize() const {
+    size_t largest = 0;
+    for (const std::vector<int>& members : regionTerritories) largest = std::max(largest, members.size());
+    return (int)largest;
+}
+
+std::ostream& operator<<(std::ostream& os, const MapPartition& partition) {
+    size_t boundaryCount = 0;
+    for (int r = 0; r < partition.getRegionCount(); r++) boundaryCount += partition.getBoundaryTerritories(r).size();
+    os << "MapPartition(Regions:" << partition.getRegionCount() << ", Largest:" << partition.getLargestRegionSize()
+       << ", Boundary:" << boundaryCount << ", Cut edges:" << partition.getCutEdges() << ")";
+    return os;
+}
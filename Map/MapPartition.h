@@ -0,0 +1,58 @@
+#ifndef MAP_PARTITION_H
+#define MAP_PARTITION_H
+
+#include <iostream>
+#include <vector>
+
+class Map;
+
+struct MapPartitionOptions {
+    int regions = 0;            // 0 means one per thread of the shared pool
+    double imbalance = 0.05;    // a region may hold this fraction more than an even share
+    int refinePasses = 8;       // boundary passes that move territories to cut fewer edges
+};
+
+// Splits the map into regions of similar territory count for per-region work on
+// separate threads. Regions start from whole continents, packed together along the
+// continent borders they share (a continent larger than one share is split first),
+// and boundary territories are then moved to whichever neighbouring region removes the
+// most cut edges while the sizes stay balanced. Territories of one region are only
+// adjacent to territories of another through its boundary, so orders whose territories
+// all lie in one region cannot touch another region's territories.
+// Regions are not guaranteed to be connected, and there may be fewer than requested
+// when continents cannot be packed any tighter. Like MapDistanceIndex, the partition
+// copies what it needs and does not depend on the map afterwards.
+class MapPartition {
+public:
+    explicit MapPartition(const Map& map, const MapPartitionOptions& options = MapPartitionOptions());
+    MapPartition(const MapPartition& other);  // Copy constructor
+    MapPartition& operator=(const MapPartition& other);  // Assignment operator
+    ~MapPartition() {}
+
+    int getRegionCount() const;
+    int getRegion(int id) const;                        // -1 for ids that are not territories
+    // Region holding both territories, or -1 when they are in different regions
+    int getCommonRegion(int a, int b) const;
+    bool isBoundary(int id) const;                      // has a neighbour in another region
+
+    const std::vector<int>& getTerritories(int region) const;          // sorted ids
+    const std::vector<int>& getBoundaryTerritories(int region) const;  // sorted ids
+    const std::vector<int>& getNeighbourRegions(int region) const;     // sorted region ids
+
+    int getCutEdges() const;                            // undirected edges between regions
+    int getLargestRegionSize() const;
+
+    friend std::ostream& operator<<(std::ostream& os, const MapPartition& partition);
+
+private:
+    std::vector<int> regionOf;                          // per id, -1 for unused ids
+    std::vector<char> boundary;                         // per id
+    std::vector<std::vector<int>> regionTerritories;
+    std::vector<std::vector<int>> regionBoundary;
+    std::vector<std::vector<int>> regionNeighbours;
+    int cutEdges;
+
+    void finish(const std::vector<int>& offsets, const std::vector<int>& targets);
+};
+
+#endif
@@ -2,49 +2,20 @@
 
 #include <sstream>
 #include <algorithm>
-#include <set>
-#include <utility>
 
 #include "../Cards/Cards.h"
 
 #include "../Player/Player.h"
 #include "../Map/Map.h"
+#include "../Game_Engine/GameContext.h"
 
 using std::string;
 using std::vector;
 using std::ostream;
 using std::ostringstream;
 
-static std::string safeDeref(const std::string *p) {
-    if (p) return *p;
-    return std::string("(null)");
-}
-
-// Anonymous namespace for internal helper functions and state
+// Anonymous namespace for internal helper functions
 namespace {
-    using PlayerPair = std::pair<Player*, Player*>;     // pair of players involved in negotiation
-
-    static std::set<PlayerPair> gNegotiatedPairs;  // set of player pairs with active negotiations
-    static std::set<Player*> gPlayersGrantedCard;     // set of players who have been granted a card
-    static Player* gNeutralPlayer = nullptr;    // singleton neutral player
-
-    // Create a consistent ordering for a player pair
-    static PlayerPair makePair(Player* a, Player* b) {
-        // Ensure the first player is always the "lesser" one
-        if (a < b) {
-            return {a, b};
-        }
-        return {b, a};
-    }
-
-    // Check if there is an active negotiation between two players
-    static bool hasNegotiation(Player* a, Player* b) {
-        if (!a || !b) {
-            return false;
-        }
-        return gNegotiatedPairs.count(makePair(a, b)) > 0;  // Check both orderings
-    }
-
     // Check if two territories are adjacent
     static bool isAdjacent(Territory* from, Territory* to) {
         if (!from || !to) {
@@ -99,19 +70,12 @@ namespace {
         return false;           // Not found
     }
 
-    // Ensure the singleton neutral player exists
-    static void ensureNeutralPlayerExists() {
-        if (!gNeutralPlayer) {
-            gNeutralPlayer = new Player("Neutral");     // Create neutral player if it doesn't exist
-        }
-    }
-
     // Grant a reinforcement card to a player for conquering a territory this turn
-    static void grantCardForConquest(Player* player) {
+    static void grantCardForConquest(GameContext& context, Player* player) {
         if (!player) {      // Null check
             return;
         }
-        if (gPlayersGrantedCard.count(player) > 0) {        // Already granted a card this turn
+        if (context.wasCardGranted(player)) {        // Already granted a card this turn
             return;
         }
         if (!player->getHand()) {
@@ -119,32 +83,242 @@ namespace {
         }
         // Grant the reinforcement card
         player->getHand()->addCardToHand(new WarzoneCard::Card(WarzoneCard::CardType::Reinforcement));
-        gPlayersGrantedCard.insert(player);     // Mark player as granted
+        context.markCardGranted(player);     // Mark player as granted
+    }
+
+    // Order rules, shared by the order classes and CompactOrder. Each check returns
+    // nullptr when the order may go ahead, otherwise the reason it may not.
+    static const char* checkDeploy(Player* issuer, Territory* territory, int armies) {
+        if (!issuer) return "Invalid: no issuing player";       // Check for issuing player
+        if (!territory) return "Invalid: no territory specified";       // Check for specified territory
+        if (armies <= 0) return "Invalid: non-positive armies";     // Check for positive army count
+        if (territory->getOwner() != issuer) return "Invalid: territory not owned by issuer";       // Check ownership
+        return nullptr;
+    }
+
+    static const char* checkAdvance(const GameContext& context, Player* issuer, Territory* source,
+                                    Territory* destination, int armies) {
+        if (!issuer) return "Invalid: no issuing player";       // Check for issuing player
+        if (!source || !destination) return "Invalid: missing source or destination";      // Check for specified territories
+        if (source == destination) return "Invalid: source and destination are the same";      // Check for different territories
+        if (armies <= 0) return "Invalid: non-positive armies";     // Check for positive army count
+        if (source->getOwner() != issuer) return "Invalid: source territory not owned by issuer";      // Check ownership
+        if (!isAdjacent(source, destination)) return "Invalid: territories are not adjacent";     // Check adjacency
+        if (armies > source->getArmies()) return "Invalid: not enough armies in source";      // Check for sufficient armies
+
+        // Check for negotiation between issuer and defender
+        Player* defender = destination->getOwner();
+        if (defender && defender != issuer && context.hasNegotiation(issuer, defender)) {
+            return "Invalid: negotiation in effect";        // Negotiation blocks attack
+        }
+        return nullptr;
+    }
+
+    static const char* checkBomb(Player* issuer, Territory* target) {
+        if (!issuer) return "Invalid: no issuing player";       // Check for issuing player
+        if (!target) return "Invalid: no target";       // Check for specified target
+        Player* owner = target->getOwner();
+        if (!owner || owner == issuer) return "Invalid: target not owned by an enemy";      // Check that target is owned by an enemy
+        if (!territoryTouchesPlayer(target, issuer)) return "Invalid: no adjacent territory";     // Check adjacency to issuer's territories
+        return nullptr;
+    }
+
+    static const char* checkBlockade(Player* issuer, Territory* target) {
+        if (!target) return "Invalid: no target";
+        if (!issuer) return "Invalid: no issuer";
+        if (target->getOwner() != issuer) return "Invalid: issuer does not own target";
+        return nullptr;
+    }
+
+    static const char* checkAirlift(Player* issuer, Territory* source, Territory* destination, int armies) {
+        if (!issuer) return "Invalid: no issuing player";       // Check for issuing player
+        if (!source || !destination) return "Invalid: missing source/destination";     // Check for specified territories
+        if (armies <= 0) return "Invalid: non-positive armies";     // Check for positive army count
+        if (source->getOwner() != issuer || destination->getOwner() != issuer) {
+            return "Invalid: source or destination not owned by issuer";        // Check ownership
+        }
+        if (armies > source->getArmies()) return "Invalid: not enough armies in source";      // Check for sufficient armies
+        return nullptr;
+    }
+
+    static const char* checkNegotiate(Player* issuer, Player* targetPlayer) {
+        if (!issuer) return "Invalid: no issuing player";       // Check for issuing player
+        if (!targetPlayer) return "Invalid: no player";     // Check for specified target player
+        if (targetPlayer == issuer) return "Invalid: cannot negotiate with self";       // Cannot negotiate with self
+        return nullptr;
+    }
+
+    // What an executed advance did, for the effect text
+    struct AdvanceResult {
+        int moved;
+        int sourceBefore;
+        int destinationBefore;
+        int attackersLost;
+        int defendersLeft;
+        int attackersLeft;
+        bool friendly;
+        bool conquered;
+    };
+
+    // Moves armies between friendly territories, or resolves the combat with an enemy one
+    static AdvanceResult applyAdvance(GameContext& context, Player* issuer, Territory* source,
+                                      Territory* destination, int armies) {
+        AdvanceResult result{};
+        result.sourceBefore = source->getArmies();      // Current armies in source territory
+        result.moved = std::min(armies, result.sourceBefore);       // Armies to move
+        source->setArmies(result.sourceBefore - result.moved);      // Update source territory armies
+
+        Player* defender = destination->getOwner();         // Get defender player
+        result.friendly = (defender == issuer);           // Check if move is friendly
+        result.destinationBefore = destination->getArmies();
+        if (result.friendly) {
+            destination->setArmies(result.destinationBefore + result.moved);     // Update destination territory armies
+            return result;
+        }
+
+        // Combat resolution for hostile advance
+        int attackKills = std::min(result.destinationBefore, (result.moved * 6) / 10);      // Attackers kill 60%
+        result.attackersLost = std::min(result.moved, (result.destinationBefore * 7) / 10);     // Defenders kill 70%
+        result.defendersLeft = result.destinationBefore - attackKills;      // Remaining defenders
+        result.attackersLeft = result.moved - result.attackersLost;         // Remaining attackers
+
+        if (result.defendersLeft <= 0) {           // Attackers conquered the territory
+            result.conquered = true;
+            if (defender) {
+                removeTerritoryFromPlayer(defender, destination);       // Remove territory from defender
+            }
+            destination->setOwner(issuer);              // Set new owner to issuer
+            if (!playerOwnsTerritory(issuer, destination)) {        // Add territory to issuer if not already owned
+                issuer->addTerritory(destination);      // Add territory to issuer
+            }
+            destination->setArmies(result.attackersLeft > 0 ? result.attackersLeft : 1);     // At least 1 army must occupy
+            grantCardForConquest(context, issuer);           // Grant card for conquest
+        } else {        // Attack failed, update armies accordingly
+            destination->setArmies(result.defendersLeft);
+            if (result.attackersLeft > 0) {
+                source->setArmies(source->getArmies() + result.attackersLeft);  // Return surviving attackers
+            }
+        }
+        return result;
+    }
+
+    // Doubles the armies on the target and hands it to the neutral player
+    static void applyBlockade(GameContext& context, Player* issuer, Territory* target) {
+        Player* neutral = context.getNeutralPlayer();        // Created on first blockade
+        target->setArmies(target->getArmies() * 2);      // Double the armies
+        removeTerritoryFromPlayer(issuer, target);      // Remove territory from issuer
+        target->setOwner(neutral);       // Set neutral as new owner
+        if (!playerOwnsTerritory(neutral, target)) {     // Add territory to neutral if not already owned
+            neutral->addTerritory(target);       // Add territory to neutral player
+        }
+    }
+
+    // Versions of a territory an order reads; a missing one never changes
+    static unsigned long long versionOf(const Territory* t) {
+        return t ? t->getVersion() : 0;
+    }
+
+    static unsigned long long ownerVersionOf(const Territory* t) {
+        return t ? t->getOwnerVersion() : 0;
+    }
+
+    // Effect of an order that changed armies on up to two territories; the after
+    // counts are read from the territories
+    static OrderEffect territoryEffect(OrderOutcome outcome, int armies, Territory* source, int sourceBefore,
+                                       Territory* target, int targetBefore) {
+        OrderEffect e;
+        e.outcome = outcome;
+        e.armies = armies;
+        e.source = source;
+        e.sourceBefore = sourceBefore;
+        e.sourceAfter = source ? source->getArmies() : 0;
+        e.target = target;
+        e.targetBefore = targetBefore;
+        e.targetAfter = target ? target->getArmies() : 0;
+        return e;
+    }
+
+    // The effect text the orders used to build on execute()
+    static std::string renderEffect(const OrderEffect& e, const Player* issuer) {
+        ostringstream ss;
+        switch (e.outcome) {
+        case OrderOutcome::None:
+            break;
+        case OrderOutcome::Invalid:
+            ss << e.reason;
+            break;
+        case OrderOutcome::Deployed:
+            ss << "Deploy: " << issuer->getName() << " placed " << e.armies
+               << " armies on " << e.target->getName() << " (" << e.targetBefore << " -> "
+               << e.targetAfter << ")";
+            break;
+        case OrderOutcome::Moved:
+            ss << "Advance: moved " << e.armies << " armies from "
+               << e.source->getName() << " (" << e.sourceBefore << " -> "
+               << e.sourceAfter << ") to " << e.target->getName()
+               << " (" << e.targetBefore << " -> " << e.targetAfter << ")";
+            break;
+        case OrderOutcome::Conquered:
+            ss << "Advance: " << issuer->getName() << " conquered "
+               << e.target->getName() << " by moving " << e.armies
+               << " armies. Defenders were " << e.targetBefore
+               << " and " << e.attackersLost << " attackers were lost. "
+               << "New owner holds " << e.targetAfter << " armies.";
+            break;
+        case OrderOutcome::AttackFailed:
+            ss << "Advance: attack on " << e.target->getName()
+               << " failed. Defenders now " << e.targetAfter
+               << ", attackers returned " << std::max(e.armies - e.attackersLost, 0)
+               << ".";
+            break;
+        case OrderOutcome::Bombed:
+            ss << "Bomb: " << issuer->getName() << " halved armies on "
+               << e.target->getName() << " (" << e.targetBefore << " -> " << e.targetAfter << ")";
+            break;
+        case OrderOutcome::Blockaded:
+            ss << "Blockade: " << issuer->getName() << " doubled armies on "
+               << e.target->getName() << " (" << e.targetBefore << " -> " << e.targetAfter
+               << ") and handed it to Neutral";
+            break;
+        case OrderOutcome::Airlifted:
+            ss << "Airlift: moved " << e.armies << " armies from " << e.source->getName()
+               << " (" << e.sourceBefore << " -> " << e.sourceAfter << ") to "
+               << e.target->getName() << " (" << e.targetBefore << " -> "
+               << e.targetAfter << ")";
+            break;
+        case OrderOutcome::Negotiated:
+            ss << "Negotiate: " << issuer->getName() << " and "
+               << e.otherPlayer->getName() << " agreed to temporary peace";
+            break;
+        }
+        return ss.str();
     }
 }
 
-// Default constructor - creates an order with unknown type
-Order::Order() {
-    orderType = new std::string("Unknown");
-    effect = new std::string("");
-    executed = new bool(false);
-    issuer = nullptr;
+const char* orderKindName(OrderKind kind) {
+    static const char* names[] = {"Deploy", "Advance", "Bomb", "Blockade", "Airlift", "Negotiate"};
+    return names[(int)kind];
 }
 
-// Constructor with type and issuer - creates an order with specified parameters
-Order::Order(const std::string &type, Player *iss) {
-    orderType = new std::string(type);
-    effect = new std::string("");
+// Constructor with type tag and issuer - each order class passes its own kKind
+Order::Order(OrderKind k, Player *iss) {
+    kind = k;
     executed = new bool(false);
     issuer = iss;
+    hasVerdict = false;
+    verdictProblem = nullptr;
+    verdictStamp = 0;
 }
 
 // Copy constructor
 Order::Order(const Order &other) {
-    orderType = new std::string(*(other.orderType));
-    effect = new std::string(*(other.effect));
+    kind = other.kind;
+    effect = other.effect;
     executed = new bool(*(other.executed));
     issuer = other.issuer; 
+    hasVerdict = other.hasVerdict;
+    verdictProblem = other.verdictProblem;
+    verdictStamp = other.verdictStamp;
 }
 
 // Assignment operator
@@ -153,35 +327,100 @@ Order &Order::operator=(const Order &other) {
         return *this;
     }
 
-    delete orderType;
-    delete effect;
     delete executed;
 
-    orderType = new std::string(*(other.orderType));
-    effect = new std::string(*(other.effect));
+    kind = other.kind;
+    effect = other.effect;
     executed = new bool(*(other.executed));
     issuer = other.issuer;
+    hasVerdict = other.hasVerdict;
+    verdictProblem = other.verdictProblem;
+    verdictStamp = other.verdictStamp;
     return *this;
 }
 
 Order::~Order() {
-    delete orderType;
-    delete effect;
     delete executed;
 }
 
 std::string Order::getType() const {
-    return safeDeref(orderType);
+    return orderKindName(kind);
+}
+
+OrderKind Order::getKind() const {
+    return kind;
+}
+
+OrderPriority Order::getPriority() const {
+    return orderPriority(kind);
 }
 
 std::string Order::getEffectDescription() const {
-    return safeDeref(effect);
+    return renderEffect(effect, issuer);
+}
+
+const OrderEffect& Order::getEffect() const {
+    return effect;
 }
 
 Player* Order::getIssuer() const {
     return issuer;
 }
 
+bool Order::isExecuted() const {
+    return executed && *executed;
+}
+
+// Validate, then carry the order out; observers hear about it either way
+void Order::execute(GameContext& context) {
+    hasVerdict = false;
+    *executed = validate(context);
+    if (*executed) {
+        perform(context);
+    }
+    notifyObservers(*this);
+}
+
+// A problem becomes the Invalid effect at once, unlike precheck()
+bool Order::validate(GameContext& context) {
+    const char* problem = findProblem(context);
+    if (problem) {
+        return reject(problem);
+    }
+    return true;
+}
+
+// Leaves the effect alone; a rejection is recorded only when the order runs
+void Order::precheck(GameContext& context) {
+    verdictProblem = findProblem(context);
+    verdictStamp = getInputStamp(context);
+    hasVerdict = true;
+}
+
+// Earlier orders that touched this one's territories change its stamp and force a
+// fresh findProblem(); otherwise the precheck verdict stands
+bool Order::executeChecked(GameContext& context) {
+    bool reused = hasVerdict && verdictStamp == getInputStamp(context);
+    const char* problem = reused ? verdictProblem : findProblem(context);
+    hasVerdict = false;
+    *executed = problem == nullptr;
+    if (problem) {
+        reject(problem);
+    } else {
+        perform(context);
+    }
+    notifyObservers(*this);
+    return reused;
+}
+
+// Validation failures keep the reason until the order is validated or executed again
+bool Order::reject(const char* reason) {
+    effect = OrderEffect();
+    effect.outcome = OrderOutcome::Invalid;
+    effect.reason = reason;
+    return false;
+}
+
 std::string Order::stringToLog() const {
     std::string issuerName = "(no issuer)";
     if (issuer) {
@@ -191,22 +430,22 @@ std::string Order::stringToLog() const {
 }
 
 ostream &operator<<(ostream &os, const Order &o) {
-    os << "Order(" << safeDeref(o.orderType) << ", executed=";
+    os << "Order(" << orderKindName(o.kind) << ", executed=";
     if (o.executed && *(o.executed)) os << "yes";
     else os << "no";
     os << ")";
-    if (o.effect && !o.effect->empty()) {
-        os << " effect='" << *o.effect << "'";
+    if (o.effect.outcome != OrderOutcome::None) {
+        os << " effect='" << o.getEffectDescription() << "'";
     }
     return os;
 }
 
-Deploy::Deploy() : Order("Deploy") {
+Deploy::Deploy() : Order(kKind) {
     armies = new int(0);
     territory = nullptr;
 }
 
-Deploy::Deploy(int a, Territory *t, Player *iss) : Order("Deploy", iss) {
+Deploy::Deploy(int a, Territory *t, Player *iss) : Order(kKind, iss) {
     armies = new int(a);
     territory = t;
 }
@@ -235,7 +474,7 @@ Deploy::~Deploy() {
 }
 
 // Validate deploy order - checks if territory and army count are valid
-bool Deploy::validate() {
+const char* Deploy::findProblem(const GameContext&) const {
     /* Part 1 validation logic kept for reference
     if (!territory) {
         *effect = "Invalid: no territory specified";
@@ -248,27 +487,11 @@ bool Deploy::validate() {
     return true;
     */
 
-    if (!issuer) {
-        *effect = "Invalid: no issuing player";     // Check for issuing player
-        return false;
-    }
-    if (!territory) {
-        *effect = "Invalid: no territory specified";        // Check for specified territory
-        return false;
-    }
-    if (!armies || *armies <= 0) {
-        *effect = "Invalid: non-positive armies";       // Check for positive army count
-        return false;
-    }
-    if (territory->getOwner() != issuer) {
-        *effect = "Invalid: territory not owned by issuer";     // Check ownership
-        return false;
-    }
-    return true;
+    return checkDeploy(issuer, territory, armies ? *armies : 0);
 }
 
-// Execute deploy order - adds armies to the specified territory
-void Deploy::execute() {
+// Carry out deploy order - adds armies to the specified territory
+void Deploy::perform(GameContext&) {
     /* Part 1 execution logic kept for reference
     if (!validate()) {
         *executed = false;
@@ -286,36 +509,29 @@ void Deploy::execute() {
     *executed = true;
     */
 
-    if (!validate()) {
-        *executed = false;
-        notifyObservers();
-        return;
-    }
-
     int before = territory->getArmies();        // Current armies on territory
     int deployAmount = *armies;                 // Amount to deploy
     territory->setArmies(before + deployAmount);        // Update territory armies
 
-    // Log the effect of the deployment
-    ostringstream ss;
-    ss << "Deploy: " << issuer->getName() << " placed " << deployAmount
-       << " armies on " << territory->getName() << " (" << before << " -> "
-       << territory->getArmies() << ")";
-    *effect = ss.str();     // Set effect description
-    *executed = true;       // Mark as executed
-    notifyObservers();
+    // Record the effect of the deployment
+    effect = territoryEffect(OrderOutcome::Deployed, deployAmount, nullptr, 0, territory, before);
 }
 
 Order *Deploy::clone() const {
     return new Deploy(*this);
 }
 
-Advance::Advance() : Order("Advance") {
+// The owner of the territory
+unsigned long long Deploy::getInputStamp(const GameContext&) const {
+    return ownerVersionOf(territory);
+}
+
+Advance::Advance() : Order(kKind) {
     armies = new int(0);
     source = nullptr;
     destination = nullptr;
 }
-Advance::Advance(int a, Territory *src, Territory *dst, Player *iss) : Order("Advance", iss) {
+Advance::Advance(int a, Territory *src, Territory *dst, Player *iss) : Order(kKind, iss) {
     armies = new int(a);
     source = src;
     destination = dst;
@@ -346,7 +562,7 @@ Advance::~Advance() {
 }
 
 // Validate advance order - checks if territories and army count are valid
-bool Advance::validate() {
+const char* Advance::findProblem(const GameContext& context) const {
     /* Part 1 validation logic kept for reference
     if (!source || !destination) {
         *effect = "Invalid: missing source or destination";
@@ -359,46 +575,11 @@ bool Advance::validate() {
     return true;
     */
 
-    if (!issuer) {
-        *effect = "Invalid: no issuing player";     // Check for issuing player
-        return false;
-    }
-    if (!source || !destination) {
-        *effect = "Invalid: missing source or destination";     // Check for specified territories
-        return false;
-    }
-    if (source == destination) {
-        *effect = "Invalid: source and destination are the same";       // Check for different territories
-        return false;
-    }
-    if (!armies || *armies <= 0) {
-        *effect = "Invalid: non-positive armies";       // Check for positive army count
-        return false;
-    }
-    if (source->getOwner() != issuer) {
-        *effect = "Invalid: source territory not owned by issuer";     // Check ownership
-        return false;
-    }
-    if (!isAdjacent(source, destination)) {
-        *effect = "Invalid: territories are not adjacent";       // Check adjacency
-        return false;
-    }
-    if (*armies > source->getArmies()) {
-        *effect = "Invalid: not enough armies in source";       // Check for sufficient armies
-        return false;
-    }
-
-    // Check for negotiation between issuer and defender
-    Player* defender = destination->getOwner();
-    if (defender && defender != issuer && hasNegotiation(issuer, defender)) {
-        *effect = "Invalid: negotiation in effect";     // Negotiation blocks attack
-        return false;
-    }
-    return true;
+    return checkAdvance(context, issuer, source, destination, armies ? *armies : 0);
 }
 
-// Execute advance order - moves armies from source to target territory
-void Advance::execute() {
+// Carry out advance order - moves armies from source to target territory
+void Advance::perform(GameContext& context) {
     /* Part 1 execution logic kept for reference
     if (!validate()) {
         *executed = false;
@@ -422,88 +603,29 @@ void Advance::execute() {
     *executed = true;
     */
 
-    if (!validate()) {
-        *executed = false;
-        notifyObservers();
-        return;
-    }
-
-    int sourceBefore = source->getArmies();     // Current armies in source territory
-    int moveCount = std::min(*armies, sourceBefore);        // Armies to move
-    source->setArmies(sourceBefore - moveCount);            // Update source territory armies
-
-    Player* defender = destination->getOwner();         // Get defender player
-    bool friendlyMove = (defender == issuer);           // Check if move is friendly
-
-    if (friendlyMove) {
-        int destBefore = destination->getArmies();      // Current armies in destination territory
-        destination->setArmies(destBefore + moveCount);   // Update destination territory armies
-
-        // Log the effect of the friendly move
-        ostringstream ss;
-        ss << "Advance: moved " << moveCount << " armies from "
-           << source->getName() << " (" << sourceBefore << " -> "
-           << source->getArmies() << ") to " << destination->getName()
-           << " (" << destBefore << " -> " << destination->getArmies() << ")";
-        *effect = ss.str();
-        *executed = true;
-        notifyObservers();
-        return;
-    }
-    // Combat resolution for hostile advance
-    int defendersBefore = destination->getArmies();         // Current armies in destination territory
-    int attackKills = std::min(defendersBefore, (moveCount * 6) / 10);      // Attackers kill 60%
-    int defendKills = std::min(moveCount, (defendersBefore * 7) / 10);      // Defenders kill 70%
-    int defendersLeft = defendersBefore - attackKills;      // Remaining defenders
-    int attackersLeft = moveCount - defendKills;        // Remaining attackers
-
-    // Log the outcome of the combat
-    if (defendersLeft <= 0) {           // Attackers conquered the territory
-        if (defender) {
-            removeTerritoryFromPlayer(defender, destination);       // Remove territory from defender
-        }
-        destination->setOwner(issuer);              // Set new owner to issuer
-        if (!playerOwnsTerritory(issuer, destination)) {        // Add territory to issuer if not already owned
-            issuer->addTerritory(destination);      // Add territory to issuer
-        }
-        int occupyingArmies = (attackersLeft > 0) ? attackersLeft : 1;      // At least 1 army must occupy
-        destination->setArmies(occupyingArmies);        // Set occupying armies
-        grantCardForConquest(issuer);           // Grant card for conquest
-
-        // Log the effect of the conquest
-        ostringstream ss;
-        ss << "Advance: " << issuer->getName() << " conquered "
-           << destination->getName() << " by moving " << moveCount
-           << " armies. Defenders were " << defendersBefore
-           << " and " << defendKills << " attackers were lost. "
-           << "New owner holds " << destination->getArmies() << " armies.";
-        *effect = ss.str();
-    } else {        // Attack failed, update armies accordingly
-        destination->setArmies(defendersLeft);
-        if (attackersLeft > 0) {
-            source->setArmies(source->getArmies() + attackersLeft);  // Return surviving attackers
-        }
+    AdvanceResult result = applyAdvance(context, issuer, source, destination, *armies);
 
-        ostringstream ss;
-        ss << "Advance: attack on " << destination->getName()
-           << " failed. Defenders now " << defendersLeft
-           << ", attackers returned " << (attackersLeft > 0 ? attackersLeft : 0)
-           << ".";
-        *effect = ss.str();
-    }
+    // Record the effect of the move, conquest or failed attack
+    OrderOutcome outcome = result.friendly ? OrderOutcome::Moved
+                         : result.conquered ? OrderOutcome::Conquered : OrderOutcome::AttackFailed;
+    effect = territoryEffect(outcome, result.moved, source, result.sourceBefore, destination, result.destinationBefore);
+    effect.attackersLost = result.attackersLost;
 
-    *executed = true;
-    notifyObservers();
 }
 
 Order *Advance::clone() const {
     return new Advance(*this);
 }
 
-Bomb::Bomb() : Order("Bomb") {
+// Owner and armies of the source, owner of the destination, and the negotiations
+unsigned long long Advance::getInputStamp(const GameContext& context) const {
+    return versionOf(source) + ownerVersionOf(destination) + context.getNegotiationVersion();
+}
+
+Bomb::Bomb() : Order(kKind) {
     target = nullptr;
 }
-Bomb::Bomb(Territory *t, Player *iss) : Order("Bomb", iss) {
+Bomb::Bomb(Territory *t, Player *iss) : Order(kKind, iss) {
     target = t;
 }
 // Copy constructor
@@ -523,7 +645,7 @@ Bomb::~Bomb() {
 }
 
 // Validate bomb order - checks if target territory is valid
-bool Bomb::validate() {
+const char* Bomb::findProblem(const GameContext&) const {
     /* Part 1 validation logic kept for reference
     if (!target) {
         *effect = "Invalid: no target";
@@ -532,28 +654,11 @@ bool Bomb::validate() {
     return true;
     */
 
-    if (!issuer) {
-        *effect = "Invalid: no issuing player";         // Check for issuing player
-        return false;
-    }
-    if (!target) {
-        *effect = "Invalid: no target";     // Check for specified target
-        return false;
-    }
-    Player* owner = target->getOwner();
-    if (!owner || owner == issuer) {
-        *effect = "Invalid: target not owned by an enemy";      // Check that target is owned by an enemy
-        return false;
-    }
-    if (!territoryTouchesPlayer(target, issuer)) {
-        *effect = "Invalid: no adjacent territory";     // Check adjacency to issuer's territories
-        return false;
-    }
-    return true;
+    return checkBomb(issuer, target);
 }
 
-// Execute bomb order - destroys half the armies on target territory
-void Bomb::execute() {
+// Carry out bomb order - destroys half the armies on target territory
+void Bomb::perform(GameContext&) {
     /* Part 1 execution logic kept for reference
     if (!validate()) {
         *executed = false;
@@ -570,33 +675,34 @@ void Bomb::execute() {
     *executed = true;
     */
 
-    if (!validate()) {
-        *executed = false;
-        notifyObservers();
-        return;
-    }
-
     int before = target->getArmies();       // Current armies on target territory
     int after = before / 2;          // Armies after bombing
     target->setArmies(after);       // Update territory armies
 
-    // Log the effect of the bombing
-    ostringstream ss;
-    ss << "Bomb: " << issuer->getName() << " halved armies on "
-       << target->getName() << " (" << before << " -> " << after << ")";
-    *effect = ss.str();
-    *executed = true;
-    notifyObservers();
+    // Record the effect of the bombing
+    effect = territoryEffect(OrderOutcome::Bombed, 0, nullptr, 0, target, before);
 }
 
 Order *Bomb::clone() const {
     return new Bomb(*this);
 }
 
-Blockade::Blockade() : Order("Blockade") {
+// The target's owner, and whether the issuer still holds a territory next to it.
+// Adjacency in a map is undirected, so those are the target's own neighbours.
+unsigned long long Bomb::getInputStamp(const GameContext&) const {
+    unsigned long long stamp = ownerVersionOf(target);
+    if (target) {
+        for (Territory* neighbor : target->getAdjacents()) {
+            stamp += ownerVersionOf(neighbor);
+        }
+    }
+    return stamp;
+}
+
+Blockade::Blockade() : Order(kKind) {
     target = nullptr;
 }
-Blockade::Blockade(Territory *t, Player *iss) : Order("Blockade", iss) {
+Blockade::Blockade(Territory *t, Player *iss) : Order(kKind, iss) {
     target = t;
 }
 // Copy constructor
@@ -616,25 +722,12 @@ Blockade::~Blockade() {
 }
 
 // Validate blockade order - checks if territory is valid and owned by issuer
-bool Blockade::validate() {
-    if (!target) {
-        *effect = "Invalid: no target";
-        return false;
-    }
-    if (!issuer) {
-        *effect = "Invalid: no issuer";
-        return false;
-    }
-    Player *owner = target->getOwner();
-    if (owner != issuer) {
-        *effect = "Invalid: issuer does not own target";
-        return false;
-    }
-    return true;
+const char* Blockade::findProblem(const GameContext&) const {
+    return checkBlockade(issuer, target);
 }
 
-// Execute blockade order - doubles armies and transfers territory to neutral
-void Blockade::execute() {
+// Carry out blockade order - doubles armies and transfers territory to neutral
+void Blockade::perform(GameContext& context) {
     /* Part 1 execution logic kept for reference
     if (!validate()) {
         *executed = false;
@@ -657,43 +750,28 @@ void Blockade::execute() {
     *executed = true;
     */
 
-    if (!validate()) {
-        *executed = false;
-        notifyObservers();
-        return;
-    }
-
-    ensureNeutralPlayerExists();        // Ensure neutral player exists
-
     int before = target->getArmies();       // Current armies on target territory
-    target->setArmies(before * 2);      // Double the armies
-
-    removeTerritoryFromPlayer(issuer, target);      // Remove territory from issuer
-    target->setOwner(gNeutralPlayer);       // Set neutral as new owner
-    if (!playerOwnsTerritory(gNeutralPlayer, target)) {     // Add territory to neutral if not already owned
-        gNeutralPlayer->addTerritory(target);       // Add territory to neutral player
-    }
+    applyBlockade(context, issuer, target);
 
-    // Log the effect of the blockade
-    ostringstream ss;
-    ss << "Blockade: " << issuer->getName() << " doubled armies on "
-       << target->getName() << " (" << before << " -> " << target->getArmies()
-       << ") and handed it to Neutral";
-    *effect = ss.str();
-    *executed = true;
-    notifyObservers();
+    // Record the effect of the blockade
+    effect = territoryEffect(OrderOutcome::Blockaded, 0, nullptr, 0, target, before);
 }
 
 Order *Blockade::clone() const {
     return new Blockade(*this);
 }
 
-Airlift::Airlift() : Order("Airlift") {
+// The owner of the target
+unsigned long long Blockade::getInputStamp(const GameContext&) const {
+    return ownerVersionOf(target);
+}
+
+Airlift::Airlift() : Order(kKind) {
     armies = new int(0);
     source = nullptr;
     destination = nullptr;
 }
-Airlift::Airlift(int a, Territory *src, Territory *dst, Player *iss) : Order("Airlift", iss) {
+Airlift::Airlift(int a, Territory *src, Territory *dst, Player *iss) : Order(kKind, iss) {
     armies = new int(a);
     source = src;
     destination = dst;
@@ -721,7 +799,7 @@ Airlift::~Airlift() {
 }
 
 // Validate airlift order - checks if territories and army count are valid
-bool Airlift::validate() {
+const char* Airlift::findProblem(const GameContext&) const {
     /* Part 1 validation logic kept for reference
     if (!source || !destination) {
         *effect = "Invalid: missing source/destination";
@@ -733,32 +811,11 @@ bool Airlift::validate() {
     }
     return true;
     */
-
-    if (!issuer) {
-        *effect = "Invalid: no issuing player";     // Check for issuing player
-        return false;
-    }
-    if (!source || !destination) {
-        *effect = "Invalid: missing source/destination";        // Check for specified territories
-        return false;
-    }
-    if (!armies || *armies <= 0) {
-        *effect = "Invalid: non-positive armies";       // Check for positive army count
-        return false;
-    }
-    if (source->getOwner() != issuer || destination->getOwner() != issuer) {
-        *effect = "Invalid: source or destination not owned by issuer";    // Check ownership
-        return false;
-    }
-    if (*armies > source->getArmies()) {
-        *effect = "Invalid: not enough armies in source";    // Check for sufficient armies
-        return false;
-    }
-    return true;
+    return checkAirlift(issuer, source, destination, armies ? *armies : 0);
 }
 
-// Execute airlift order - moves armies between any owned territories
-void Airlift::execute() {
+// Carry out airlift order - moves armies between any owned territories
+void Airlift::perform(GameContext&) {
     /* Part 1 execution logic kept for reference
     if (!validate()) {
         *executed = false;
@@ -781,11 +838,6 @@ void Airlift::execute() {
     *executed = true;
     */
 
-    if (!validate()) {
-        *executed = false;
-        return;
-    }
-
     int srcBefore = source->getArmies();        // Current armies in source territory
     int moveCount = std::min(*armies, srcBefore);       // Armies to move
     source->setArmies(srcBefore - moveCount);         // Update source territory armies
@@ -793,25 +845,23 @@ void Airlift::execute() {
     int destBefore = destination->getArmies();      // Current armies in destination territory
     destination->setArmies(destBefore + moveCount);     // Update destination territory armies
 
-    // Log the effect of the airlift
-    ostringstream ss;
-    ss << "Airlift: moved " << moveCount << " armies from " << source->getName()
-       << " (" << srcBefore << " -> " << source->getArmies() << ") to "
-       << destination->getName() << " (" << destBefore << " -> "
-       << destination->getArmies() << ")";
-    *effect = ss.str();
-    *executed = true;
-    notifyObservers();
+    // Record the effect of the airlift
+    effect = territoryEffect(OrderOutcome::Airlifted, moveCount, source, srcBefore, destination, destBefore);
 }
 
 Order *Airlift::clone() const {
     return new Airlift(*this);
 }
 
-Negotiate::Negotiate() : Order("Negotiate") {
+// Owner and armies of the source, owner of the destination
+unsigned long long Airlift::getInputStamp(const GameContext&) const {
+    return versionOf(source) + ownerVersionOf(destination);
+}
+
+Negotiate::Negotiate() : Order(kKind) {
     targetPlayer = nullptr;
 }
-Negotiate::Negotiate(Player *p, Player *iss) : Order("Negotiate", iss) {
+Negotiate::Negotiate(Player *p, Player *iss) : Order(kKind, iss) {
     targetPlayer = p;
     issuer = iss;
 }
@@ -831,7 +881,7 @@ Negotiate::~Negotiate() {
 }
 
 // Validate negotiate order - checks if target player is valid and different
-bool Negotiate::validate() {
+const char* Negotiate::findProblem(const GameContext&) const {
     /* Part 1 validation logic kept for reference
     if (!targetPlayer) {
         *effect = "Invalid: no player";
@@ -839,24 +889,11 @@ bool Negotiate::validate() {
     }
     return true;
     */
-
-    if (!issuer) {
-        *effect = "Invalid: no issuing player";     // Check for issuing player
-        return false;
-    }
-    if (!targetPlayer) {
-        *effect = "Invalid: no player";     // Check for specified target player
-        return false;
-    }
-    if (targetPlayer == issuer) {
-        *effect = "Invalid: cannot negotiate with self";        // Cannot negotiate with self
-        return false;
-    }
-    return true;
+    return checkNegotiate(issuer, targetPlayer);
 }
 
-// Execute negotiate order - prevents attacks between players for this turn
-void Negotiate::execute() {
+// Carry out negotiate order - prevents attacks between players for this turn
+void Negotiate::perform(GameContext& context) {
     /* Part 1 execution logic kept for reference
     if (!validate()) {
         *executed = false;
@@ -870,31 +907,29 @@ void Negotiate::execute() {
     *executed = true;
     */
 
-    if (!validate()) {
-        *executed = false;
-        notifyObservers();
-        return;
-    }
-
-    gNegotiatedPairs.insert(makePair(issuer, targetPlayer));        // Record the negotiation
+    context.addNegotiation(issuer, targetPlayer);        // Record the negotiation
 
-    // Log the effect of the negotiation
-    ostringstream ss;
-    ss << "Negotiate: " << issuer->getName() << " and "
-       << targetPlayer->getName() << " agreed to temporary peace";
-    *effect = ss.str();
-    *executed = true;
-    notifyObservers();
+    // Record the effect of the negotiation
+    effect = OrderEffect();
+    effect.outcome = OrderOutcome::Negotiated;
+    effect.otherPlayer = targetPlayer;
 }
 
 Order *Negotiate::clone() const {
     return new Negotiate(*this);
 }
 
+// Only the two players, which never change
+unsigned long long Negotiate::getInputStamp(const GameContext&) const {
+    return 0;
+}
+
 OrdersList::OrdersList() {
     orders = new vector<Order *>();
     mostRecentOrder = nullptr;
     mostRecentAction = new std::string("OrdersList created.");
+    cursor = 0;
+    deployEnd = 0;
 }
 
 // Copy constructor
@@ -905,6 +940,8 @@ OrdersList::OrdersList(const OrdersList &other) {
     }
     mostRecentOrder = nullptr;
     mostRecentAction = new std::string(*(other.mostRecentAction));
+    cursor = other.cursor;
+    deployEnd = other.deployEnd;
 }
 
 // Assignment operator
@@ -923,6 +960,8 @@ OrdersList &OrdersList::operator=(const OrdersList &other) {
     }
     mostRecentOrder = nullptr;
     *mostRecentAction = *(other.mostRecentAction);
+    cursor = other.cursor;
+    deployEnd = other.deployEnd;
     return *this;
 }
 
@@ -944,7 +983,7 @@ void OrdersList::add(Order *o) {
     } else {
         *mostRecentAction = "Attempted to add a null order.";
     }
-    notifyObservers();
+    notifyObservers(*this);
 }
 
 // Remove an order at the specified index from the list
@@ -956,7 +995,7 @@ bool OrdersList::remove(int index) {
     orders->erase(orders->begin() + index);
     mostRecentOrder = nullptr;
     *mostRecentAction = "Removed order at index " + std::to_string(index);
-    notifyObservers();
+    notifyObservers(*this);
     return true;
 }
 
@@ -980,11 +1019,55 @@ bool OrdersList::move(int from, int to) {
     
     mostRecentOrder = itemToMove;
     *mostRecentAction = "Moved order " + itemToMove->getType() + " from " + std::to_string(from) + " to " + std::to_string(to);
-    notifyObservers();
+    notifyObservers(*this);
     
     return true;
 }
 
+// One pass over the priority tags; the partition point is the end of the deploy bucket
+void OrdersList::beginExecution() {
+    auto regular = std::stable_partition(orders->begin(), orders->end(), [](const Order* o) {
+        return o && o->getPriority() == OrderPriority::Deploy;
+    });
+    cursor = 0;
+    deployEnd = static_cast<size_t>(regular - orders->begin());
+}
+
+// Next order of the deploy bucket
+Order* OrdersList::nextDeploy() {
+    if (cursor >= deployEnd) {
+        return nullptr;
+    }
+    return (*orders)[cursor++];
+}
+
+// Next order of whichever bucket the cursor is in
+Order* OrdersList::next() {
+    if (cursor >= orders->size()) {
+        return nullptr;
+    }
+    return (*orders)[cursor++];
+}
+
+bool OrdersList::hasNext() const {
+    return cursor < orders->size();
+}
+
+// Deletes the taken orders and shifts the rest to the front once
+int OrdersList::endExecution() {
+    int taken = static_cast<int>(cursor);
+    for (size_t i = 0; i < cursor; i++) {
+        delete (*orders)[i];
+    }
+    orders->erase(orders->begin(), orders->begin() + cursor);
+    cursor = 0;
+    deployEnd = 0;
+    mostRecentOrder = nullptr;
+    *mostRecentAction = "Executed and removed " + std::to_string(taken) + " orders";
+    notifyObservers(*this);
+    return taken;
+}
+
 vector<Order *> *OrdersList::getOrders() const {
     return orders;
 }
@@ -1031,10 +1114,153 @@ ostream &operator<<(ostream &os, const OrdersList &ol) {
     return os;
 }
 
-// Reset the order turn state at the end of a turn
-void resetOrderTurnState() {
-    gNegotiatedPairs.clear();       // Clear negotiated pairs
-    gPlayersGrantedCard.clear();    // Clear players granted cards
+CompactOrder CompactOrder::deploy(int armies, Territory* territory, Player* issuer) {
+    return {OrderKind::Deploy, false, armies, issuer, nullptr, territory, nullptr};
+}
+
+CompactOrder CompactOrder::advance(int armies, Territory* src, Territory* dst, Player* issuer) {
+    return {OrderKind::Advance, false, armies, issuer, src, dst, nullptr};
+}
+
+CompactOrder CompactOrder::bomb(Territory* target, Player* issuer) {
+    return {OrderKind::Bomb, false, 0, issuer, nullptr, target, nullptr};
+}
+
+CompactOrder CompactOrder::blockade(Territory* target, Player* issuer) {
+    return {OrderKind::Blockade, false, 0, issuer, nullptr, target, nullptr};
+}
+
+CompactOrder CompactOrder::airlift(int armies, Territory* src, Territory* dst, Player* issuer) {
+    return {OrderKind::Airlift, false, armies, issuer, src, dst, nullptr};
+}
+
+CompactOrder CompactOrder::negotiate(Player* targetPlayer, Player* issuer) {
+    return {OrderKind::Negotiate, false, 0, issuer, nullptr, nullptr, targetPlayer};
+}
+
+const char* CompactOrder::check(const GameContext& context) const {
+    switch (kind) {
+    case OrderKind::Deploy: return checkDeploy(issuer, target, armies);
+    case OrderKind::Advance: return checkAdvance(context, issuer, source, target, armies);
+    case OrderKind::Bomb: return checkBomb(issuer, target);
+    case OrderKind::Blockade: return checkBlockade(issuer, target);
+    case OrderKind::Airlift: return checkAirlift(issuer, source, target, armies);
+    case OrderKind::Negotiate: return checkNegotiate(issuer, targetPlayer);
+    }
+    return "Invalid: unknown order";
+}
+
+bool CompactOrder::validate(const GameContext& context) const {
+    return check(context) == nullptr;
+}
+
+// Same effects as the matching class's execute()
+void CompactOrder::execute(GameContext& context) {
+    executed = validate(context);
+    if (!executed) return;
+    switch (kind) {
+    case OrderKind::Deploy:
+        target->setArmies(target->getArmies() + armies);
+        break;
+    case OrderKind::Advance:
+        applyAdvance(context, issuer, source, target, armies);
+        break;
+    case OrderKind::Bomb:
+        target->setArmies(target->getArmies() / 2);
+        break;
+    case OrderKind::Blockade:
+        applyBlockade(context, issuer, target);
+        break;
+    case OrderKind::Airlift: {
+        int moveCount = std::min(armies, source->getArmies());
+        source->setArmies(source->getArmies() - moveCount);
+        target->setArmies(target->getArmies() + moveCount);
+        break;
+    }
+    case OrderKind::Negotiate:
+        context.addNegotiation(issuer, targetPlayer);
+        break;
+    }
+}
+
+const char* CompactOrder::getType() const {
+    return orderKindName(kind);
+}
+
+Order* CompactOrder::toOrder() const {
+    switch (kind) {
+    case OrderKind::Deploy: return new Deploy(armies, target, issuer);
+    case OrderKind::Advance: return new Advance(armies, source, target, issuer);
+    case OrderKind::Bomb: return new Bomb(target, issuer);
+    case OrderKind::Blockade: return new Blockade(target, issuer);
+    case OrderKind::Airlift: return new Airlift(armies, source, target, issuer);
+    case OrderKind::Negotiate: return new Negotiate(targetPlayer, issuer);
+    }
+    return nullptr;
+}
+
+ostream &operator<<(ostream &os, const CompactOrder &o) {
+    os << "CompactOrder(" << o.getType() << ", executed=" << (o.executed ? "yes" : "no") << ")";
+    return os;
+}
+
+void CompactOrdersList::add(const CompactOrder& o) {
+    orders.push_back(o);
+}
+
+bool CompactOrdersList::remove(int index) {
+    if (index < 0 || index >= (int)orders.size()) return false;
+    orders.erase(orders.begin() + index);
+    return true;
+}
+
+// Same semantics as OrdersList::move
+bool CompactOrdersList::move(int from, int to) {
+    int n = (int)orders.size();
+    if (from < 0 || from >= n || to < 0 || to >= n) return false;
+    if (from == to) return true;
+    CompactOrder o = orders[from];
+    orders.erase(orders.begin() + from);
+    orders.insert(orders.begin() + to, o);
+    return true;
+}
+
+void CompactOrdersList::clear() {
+    orders.clear();
 }
 
+void CompactOrdersList::reserve(size_t count) {
+    orders.reserve(count);
+}
+
+size_t CompactOrdersList::size() const {
+    return orders.size();
+}
+
+bool CompactOrdersList::empty() const {
+    return orders.empty();
+}
+
+CompactOrder& CompactOrdersList::operator[](size_t index) {
+    return orders[index];
+}
+
+const CompactOrder& CompactOrdersList::operator[](size_t index) const {
+    return orders[index];
+}
 
+std::vector<CompactOrder>& CompactOrdersList::getOrders() {
+    return orders;
+}
+
+const std::vector<CompactOrder>& CompactOrdersList::getOrders() const {
+    return orders;
+}
+
+ostream &operator<<(ostream &os, const CompactOrdersList &ol) {
+    os << "CompactOrdersList(size=" << ol.orders.size() << "):\n";
+    for (size_t i = 0; i < ol.orders.size(); ++i) {
+        os << "  " << i << ": " << ol.orders[i] << "\n";
+    }
+    return os;
+}
@@ -7,46 +7,124 @@
 
 #include "../Logging/LoggingObserver.h"
 
+class GameContext;
 class Player;
 class Territory;
 
+// Type tag of an order. Each order class carries its own as kKind, so code that needs
+// to tell orders apart compares tags instead of using dynamic_cast.
+enum class OrderKind : unsigned char { Deploy, Advance, Bomb, Blockade, Airlift, Negotiate };
+
+// Execution priority class. Every order of one class is executed before any order of
+// the next: deploys first, then everything else round robin.
+enum class OrderPriority : unsigned char { Deploy, Regular };
+
+constexpr OrderPriority orderPriority(OrderKind kind) {
+    return kind == OrderKind::Deploy ? OrderPriority::Deploy : OrderPriority::Regular;
+}
+
+const char* orderKindName(OrderKind kind);
+
+// How an order turned out
+enum class OrderOutcome : unsigned char {
+    None,           // not validated or executed yet
+    Invalid,        // rejected; reason says why
+    Deployed,
+    Moved,          // advance between the issuer's own territories
+    Conquered,
+    AttackFailed,
+    Bombed,
+    Blockaded,
+    Airlifted,
+    Negotiated
+};
+
+// What an order did, kept as numbers so that execute() does no string work. The text
+// is rendered from it only when getEffectDescription(), stringToLog() or operator<<
+// asks. Territories are the pointers the order already holds; their ids and names are
+// read from them when rendering.
+struct OrderEffect {
+    OrderOutcome outcome = OrderOutcome::None;
+    const char* reason = nullptr;       // Invalid: a string literal from the order rules
+    int armies = 0;                     // deployed, moved or airlifted
+    int attackersLost = 0;              // Conquered, AttackFailed
+    Territory* source = nullptr;        // Moved, Conquered, AttackFailed, Airlifted
+    int sourceBefore = 0;
+    int sourceAfter = 0;
+    Territory* target = nullptr;        // every territory outcome
+    int targetBefore = 0;
+    int targetAfter = 0;
+    Player* otherPlayer = nullptr;      // Negotiated
+};
+
 
 class Order : public Subject, public ILoggable {
 public:
-    Order();  // Default constructor
-    explicit Order(const std::string &type, Player *issuer = nullptr);
+    explicit Order(OrderKind kind, Player *issuer = nullptr);
     Order(const Order &other);  // Copy constructor
     Order &operator=(const Order &other);  // Assignment operator       
     virtual ~Order();                             
 
-    virtual bool validate() = 0;
-    virtual void execute() = 0;
+    // Orders read and record negotiations, card grants and the neutral player through
+    // the context of the game they belong to
+    bool validate(GameContext& context);    // false, with the problem recorded as an Invalid effect, when findProblem() finds one
+    void execute(GameContext& context);     // validate(), then perform() if it passed
     virtual Order *clone() const = 0;
+
+    // Pre-execution validation. precheck() validates against the board as it is and
+    // keeps the verdict with the input stamp it was taken at. It only reads the board,
+    // so every order of a turn can be prechecked at once on several threads before any
+    // of them runs. The verdict is kept apart from the effect, which still describes the
+    // last run until executeChecked() runs the order. executeChecked() trusts the
+    // verdict while the stamp is unchanged and checks again otherwise.
+    void precheck(GameContext& context);
+    bool executeChecked(GameContext& context);     // true when the cached verdict was used
+    // Sum of the versions of what findProblem() reads: the owner version of territories
+    // whose owner it checks, the full version of those whose armies it also checks, and
+    // the negotiation version for Advance. Versions only grow, so an unchanged stamp
+    // means unchanged inputs.
+    virtual unsigned long long getInputStamp(const GameContext& context) const = 0;
     std::string stringToLog() const override;
     std::string getType() const;
-    std::string getEffectDescription() const;
+    OrderKind getKind() const;
+    OrderPriority getPriority() const;
+    std::string getEffectDescription() const;     // rendered from getEffect()
+    const OrderEffect& getEffect() const;
     Player* getIssuer() const;
+    bool isExecuted() const;
 
     friend std::ostream &operator<<(std::ostream &os, const Order &o);
 
 protected:
-    std::string *orderType;
-    std::string *effect;
+    OrderKind kind;
+    OrderEffect effect;
     bool *executed;
     Player *issuer;
+    bool hasVerdict;                // set by precheck(), cleared once the order runs
+    const char* verdictProblem;     // the precheck's findProblem(), nullptr when it passed
+    unsigned long long verdictStamp;
+
+    bool reject(const char* reason);        // records an Invalid effect, returns false
+    virtual const char* findProblem(const GameContext& context) const = 0;     // why the order cannot run, nullptr if it can
+    virtual void perform(GameContext& context) = 0;     // the order's effect; validate() has passed
 };
 
 class Deploy : public Order {
 public:
+    static constexpr OrderKind kKind = OrderKind::Deploy;
+
     Deploy();
     Deploy(int armies, Territory *territory, Player *issuer = nullptr);
     Deploy(const Deploy &other);
     Deploy &operator=(const Deploy &other);
     ~Deploy() override;
 
-    bool validate() override;
-    void execute() override;
     Order *clone() const override;
+    unsigned long long getInputStamp(const GameContext& context) const override;
+
+protected:
+    const char* findProblem(const GameContext& context) const override;
+    void perform(GameContext& context) override;
 
 private:
     int *armies;
@@ -55,15 +133,20 @@ private:
 
 class Advance : public Order {
 public:
+    static constexpr OrderKind kKind = OrderKind::Advance;
+
     Advance();
     Advance(int armies, Territory *src, Territory *dst, Player *issuer = nullptr);
     Advance(const Advance &other);
     Advance &operator=(const Advance &other);
     ~Advance() override;
 
-    bool validate() override;
-    void execute() override;
     Order *clone() const override;
+    unsigned long long getInputStamp(const GameContext& context) const override;
+
+protected:
+    const char* findProblem(const GameContext& context) const override;
+    void perform(GameContext& context) override;
 
 private:
     int *armies;
@@ -73,15 +156,20 @@ private:
 
 class Bomb : public Order {
 public:
+    static constexpr OrderKind kKind = OrderKind::Bomb;
+
     Bomb();
     Bomb(Territory *target, Player *issuer = nullptr);
     Bomb(const Bomb &other);
     Bomb &operator=(const Bomb &other);
     ~Bomb() override;
 
-    bool validate() override;
-    void execute() override;
     Order *clone() const override;
+    unsigned long long getInputStamp(const GameContext& context) const override;
+
+protected:
+    const char* findProblem(const GameContext& context) const override;
+    void perform(GameContext& context) override;
 
 private:
     Territory *target;
@@ -89,15 +177,20 @@ private:
 
 class Blockade : public Order {
 public:
+    static constexpr OrderKind kKind = OrderKind::Blockade;
+
     Blockade();
     Blockade(Territory *target, Player *issuer = nullptr);
     Blockade(const Blockade &other);
     Blockade &operator=(const Blockade &other);
     ~Blockade() override;
 
-    bool validate() override;
-    void execute() override;
     Order *clone() const override;
+    unsigned long long getInputStamp(const GameContext& context) const override;
+
+protected:
+    const char* findProblem(const GameContext& context) const override;
+    void perform(GameContext& context) override;
 
 private:
     Territory *target;
@@ -105,15 +198,20 @@ private:
 
 class Airlift : public Order {
 public:
+    static constexpr OrderKind kKind = OrderKind::Airlift;
+
     Airlift();
     Airlift(int armies, Territory *src, Territory *dst, Player *issuer = nullptr);
     Airlift(const Airlift &other);
     Airlift &operator=(const Airlift &other);
     ~Airlift() override;
 
-    bool validate() override;
-    void execute() override;
     Order *clone() const override;
+    unsigned long long getInputStamp(const GameContext& context) const override;
+
+protected:
+    const char* findProblem(const GameContext& context) const override;
+    void perform(GameContext& context) override;
 
 private:
     int *armies;
@@ -123,15 +221,20 @@ private:
 
 class Negotiate : public Order {
 public:
+    static constexpr OrderKind kKind = OrderKind::Negotiate;
+
     Negotiate();
     explicit Negotiate(Player *targetPlayer, Player *issuer = nullptr);
     Negotiate(const Negotiate &other);
     Negotiate &operator=(const Negotiate &other);
     ~Negotiate() override;
 
-    bool validate() override;
-    void execute() override;
     Order *clone() const override;
+    unsigned long long getInputStamp(const GameContext& context) const override;
+
+protected:
+    const char* findProblem(const GameContext& context) const override;
+    void perform(GameContext& context) override;
 
 private:
     Player *targetPlayer;
@@ -148,6 +251,18 @@ public:
     bool remove(int index);
     bool move(int from, int to);
 
+    // Execution queue. beginExecution() sorts the list into two stable priority buckets,
+    // deploys first and then everything else, each in the order issued, and puts a
+    // cursor at the front. nextDeploy() and next() hand out orders by moving the cursor,
+    // so each is O(1). Taken orders stay in the list until endExecution() deletes them
+    // all in one erase and notifies observers once. Call remove() and move() outside
+    // of an execution; their indices count taken orders too.
+    void beginExecution();
+    Order* nextDeploy();        // nullptr once the deploy bucket is used up
+    Order* next();              // nullptr once the list is used up
+    bool hasNext() const;
+    int endExecution();         // returns how many orders were taken
+
     std::vector<Order *> *getOrders() const;
     std::string stringToLog() const override;
     void addObserver(Observer* observer);
@@ -159,6 +274,60 @@ private:
     std::vector<Order *> *orders;
     Order* mostRecentOrder;
     std::string* mostRecentAction;
+    size_t cursor;          // first order not yet taken
+    size_t deployEnd;       // end of the deploy bucket
+};
+
+// An order as a plain value: the same rules as the order classes, but no heap
+// allocations, no virtual calls and no effect text, only whether it executed. Fields
+// an order kind does not use stay null or zero.
+struct CompactOrder {
+    OrderKind kind;
+    bool executed;
+    int armies;             // Deploy, Advance, Airlift
+    Player* issuer;
+    Territory* source;      // Advance, Airlift
+    Territory* target;      // Deploy, Bomb, Blockade, and where Advance and Airlift go
+    Player* targetPlayer;   // Negotiate
+
+    static CompactOrder deploy(int armies, Territory* territory, Player* issuer);
+    static CompactOrder advance(int armies, Territory* src, Territory* dst, Player* issuer);
+    static CompactOrder bomb(Territory* target, Player* issuer);
+    static CompactOrder blockade(Territory* target, Player* issuer);
+    static CompactOrder airlift(int armies, Territory* src, Territory* dst, Player* issuer);
+    static CompactOrder negotiate(Player* targetPlayer, Player* issuer);
+
+    // Why the order cannot run against the board as it is now, or nullptr
+    const char* check(const GameContext& context) const;
+    bool validate(const GameContext& context) const;
+    void execute(GameContext& context);
+    const char* getType() const;
+    Order* toOrder() const;     // The equivalent heap order, for code that needs one
+
+    friend std::ostream& operator<<(std::ostream& os, const CompactOrder& o);
+};
+
+// Compact orders stored by value in one contiguous vector. Unlike OrdersList it has
+// no observers and does no logging; copying it copies the vector.
+class CompactOrdersList {
+public:
+    void add(const CompactOrder& o);
+    bool remove(int index);
+    bool move(int from, int to);
+    void clear();
+    void reserve(size_t count);
+
+    size_t size() const;
+    bool empty() const;
+    CompactOrder& operator[](size_t index);
+    const CompactOrder& operator[](size_t index) const;
+    std::vector<CompactOrder>& getOrders();
+    const std::vector<CompactOrder>& getOrders() const;
+
+    friend std::ostream& operator<<(std::ostream& os, const CompactOrdersList& ol);
+
+private:
+    std::vector<CompactOrder> orders;
 };
 
 /* Part 1 driver placeholder kept for reference
@@ -166,6 +335,5 @@ void testOrdersLists();
 */
 
 void testOrderExecution();      // Test function demonstrating order execution
-void resetOrderTurnState();     // Resets turn-specific state for orders (e.g., negotiations)
 
 #endif
\ No newline at end of file
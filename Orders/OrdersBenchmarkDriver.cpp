@@ -0,0 +1,418 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include "Orders.h"
+#include "../Game_Engine/GameContext.h"
+#include "../Map/Map.h"
+#include "../Map/MapGenerator.h"
+#include "../Player/Player.h"
+#include "../ThreadPool/ThreadPool.h"
+
+// Every allocation in this program goes through here, so each phase below can report
+// how many it made. GCC cannot see that these two replace the global pair and warns
+// about new/free mismatches.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+namespace {
+    std::atomic<size_t> allocationCount{0};
+    std::atomic<size_t> allocatedBytes{0};
+}
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+    const int kPlayers = 4;
+    const int kOrders = 10000;
+
+    // One order of the benchmark turn, by territory id so it can be replayed on a fresh board
+    struct OrderSpec {
+        OrderKind kind;
+        int issuer;
+        int armies;
+        int source;
+        int target;
+        int targetPlayer;
+    };
+
+    // A 10k-order turn: mostly deploys and advances, plus a few of every other kind.
+    // Territory i starts with player i % kPlayers.
+    std::vector<OrderSpec> buildTurn(const Map& board) {
+        const std::vector<Territory*>& all = board.getTerritories();
+        std::mt19937 rng(345);
+        std::vector<OrderSpec> specs;
+        for (int k = 0; k < kOrders; k++) {
+            int issuer = k % kPlayers;
+            int owned = (int)(rng() % (all.size() / kPlayers)) * kPlayers + issuer;
+            Territory* source = all[owned];
+            Territory* neighbour = source->getAdjacents()[rng() % source->getAdjacents().size()];
+            Territory* other = all[(int)(rng() % (all.size() / kPlayers)) * kPlayers + issuer];
+            int roll = (int)(rng() % 100);
+            OrderSpec spec{OrderKind::Deploy, issuer, 1 + (int)(rng() % 5), source->getId(), neighbour->getId(), -1};
+            if (roll < 40) {
+                spec.target = source->getId();
+            } else if (roll < 80) {
+                spec.kind = OrderKind::Advance;
+            } else if (roll < 85) {
+                spec.kind = OrderKind::Bomb;
+            } else if (roll < 90) {
+                spec.kind = OrderKind::Airlift;
+                spec.target = other->getId();
+            } else if (roll < 95) {
+                spec.kind = OrderKind::Negotiate;
+                spec.targetPlayer = (issuer + 1 + (int)(rng() % (kPlayers - 1))) % kPlayers;
+            } else {
+                spec.kind = OrderKind::Blockade;
+                spec.target = source->getId();
+            }
+            specs.push_back(spec);
+        }
+        return specs;
+    }
+
+    CompactOrder makeCompact(const OrderSpec& spec, Map& board, const std::vector<Player*>& players) {
+        Player* issuer = players[spec.issuer];
+        Territory* source = board.getTerritory(spec.source);
+        Territory* target = board.getTerritory(spec.target);
+        switch (spec.kind) {
+        case OrderKind::Deploy: return CompactOrder::deploy(spec.armies, target, issuer);
+        case OrderKind::Advance: return CompactOrder::advance(spec.armies, source, target, issuer);
+        case OrderKind::Bomb: return CompactOrder::bomb(target, issuer);
+        case OrderKind::Blockade: return CompactOrder::blockade(target, issuer);
+        case OrderKind::Airlift: return CompactOrder::airlift(spec.armies, source, target, issuer);
+        case OrderKind::Negotiate: return CompactOrder::negotiate(players[spec.targetPlayer], issuer);
+        }
+        return CompactOrder::deploy(0, nullptr, nullptr);
+    }
+
+    struct Phase {
+        size_t allocations = 0;
+        size_t bytes = 0;
+        double ms = 0.0;
+    };
+
+    // Counts the allocations and time of one step
+    template <typename Step>
+    Phase measure(Step step) {
+        size_t count = allocationCount.load();
+        size_t bytes = allocatedBytes.load();
+        auto start = std::chrono::steady_clock::now();
+        step();
+        Phase phase;
+        phase.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        phase.allocations = allocationCount.load() - count;
+        phase.bytes = allocatedBytes.load() - bytes;
+        return phase;
+    }
+
+    struct TurnRun {
+        Phase issue;
+        Phase copy;
+        Phase precheck;
+        Phase execute;
+        Phase teardown;
+        int reused = 0;             // prechecked verdicts still good when the order ran
+        long long armies = 0;       // board totals after the turn, to compare the two forms
+        int neutral = 0;
+        int executed = 0;
+    };
+
+    // Gives each player its starting territories on a fresh copy of the board
+    std::vector<Player*> seatPlayers(Map& board) {
+        std::vector<Player*> players;
+        for (int p = 0; p < kPlayers; p++) {
+            players.push_back(new Player("Player" + std::to_string(p + 1)));
+        }
+        const std::vector<Territory*>& all = board.getTerritories();
+        for (size_t i = 0; i < all.size(); i++) {
+            all[i]->setOwner(players[i % kPlayers]);
+            all[i]->setArmies(10);
+            players[i % kPlayers]->addTerritory(all[i]);
+        }
+        return players;
+    }
+
+    void summarize(Map& board, const std::vector<Player*>& players, TurnRun& run) {
+        for (Territory* t : board.getTerritories()) {
+            run.armies += t->getArmies();
+            bool seated = false;
+            for (Player* p : players) seated = seated || t->getOwner() == p;
+            if (!seated) run.neutral++;
+        }
+    }
+
+    // Orders are executed one per player in turn, the way the engine's round robin does
+    // With renderEffects each executed order's effect text is also built, as a logger would.
+    // With precheck every order is validated up front on the shared pool, and execution
+    // only validates again the orders whose territories changed since.
+    TurnRun runClassTurn(const Map& original, const std::vector<OrderSpec>& specs, bool renderEffects,
+                         bool precheck = false) {
+        Map board(original);
+        std::vector<Player*> players = seatPlayers(board);
+        GameContext context;
+        std::vector<OrdersList*> lists;
+        TurnRun run;
+
+        run.issue = measure([&]() {
+            for (int p = 0; p < kPlayers; p++) {
+                lists.push_back(new OrdersList());
+            }
+            for (const OrderSpec& spec : specs) {
+                CompactOrder o = makeCompact(spec, board, players);
+                lists[spec.issuer]->add(o.toOrder());
+            }
+        });
+        run.copy = measure([&]() {
+            for (OrdersList* list : lists) {
+                OrdersList copy(*list);
+            }
+        });
+        if (precheck) {
+            run.precheck = measure([&]() {
+                std::vector<Order*> queued;
+                for (OrdersList* list : lists) {
+                    queued.insert(queued.end(), list->getOrders()->begin(), list->getOrders()->end());
+                }
+                size_t workers = ThreadPool::shared().size() + 1;
+                ThreadPool::shared().parallelFor(workers, [&](size_t slice) {
+                    for (size_t i = slice; i < queued.size(); i += workers) queued[i]->precheck(context);
+                });
+            });
+        }
+        run.execute = measure([&]() {
+            for (size_t i = 0; i < specs.size(); i++) {
+                for (OrdersList* list : lists) {
+                    if (i < list->getOrders()->size()) {
+                        Order* o = (*list->getOrders())[i];
+                        if (precheck) {
+                            if (o->executeChecked(context)) run.reused++;
+                        } else {
+                            o->execute(context);
+                        }
+                        if (o->isExecuted()) run.executed++;
+                        if (renderEffects) o->getEffectDescription();
+                    }
+                }
+            }
+        });
+        run.teardown = measure([&]() {
+            for (OrdersList* list : lists) delete list;
+        });
+
+        summarize(board, players, run);
+        for (Player* p : players) delete p;
+        return run;
+    }
+
+    TurnRun runCompactTurn(const Map& original, const std::vector<OrderSpec>& specs) {
+        Map board(original);
+        std::vector<Player*> players = seatPlayers(board);
+        GameContext context;
+        std::vector<CompactOrdersList>* lists = nullptr;
+        TurnRun run;
+
+        run.issue = measure([&]() {
+            lists = new std::vector<CompactOrdersList>(kPlayers);
+            for (const OrderSpec& spec : specs) {
+                (*lists)[spec.issuer].add(makeCompact(spec, board, players));
+            }
+        });
+        run.copy = measure([&]() {
+            for (const CompactOrdersList& list : *lists) {
+                CompactOrdersList copy(list);
+            }
+        });
+        run.execute = measure([&]() {
+            for (size_t i = 0; i < specs.size(); i++) {
+                for (CompactOrdersList& list : *lists) {
+                    if (i < list.size()) {
+                        list[i].execute(context);
+                        if (list[i].executed) run.executed++;
+                    }
+                }
+            }
+        });
+        run.teardown = measure([&]() {
+            delete lists;
+        });
+
+        summarize(board, players, run);
+        for (Player* p : players) delete p;
+        return run;
+    }
+
+    void printPhase(const Phase& phase) {
+        std::cout << std::setw(12) << phase.allocations << std::setw(10) << phase.bytes / 1024
+                  << std::fixed << std::setprecision(3) << std::setw(10) << phase.ms;
+    }
+
+    void printRun(const std::string& label, const TurnRun& run) {
+        std::cout << std::left << std::setw(24) << label << std::right;
+        printPhase(run.issue);
+        printPhase(run.copy);
+        printPhase(run.execute);
+        printPhase(run.teardown);
+        std::cout << std::endl;
+    }
+}
+
+// Builds, copies, executes and frees the same 10k-order turn as heap orders in an
+// OrdersList (with and without rendering the effect text) and as CompactOrders in a CompactOrdersList,
+// counting allocations in each phase. The boards must end up the same.
+void testCompactOrdersBenchmark() {
+    std::cout << "\n=== Compact Orders Benchmark (" << kOrders << " orders, " << kPlayers << " players) ===" << std::endl;
+    std::string file = "orders_benchmark.map";
+    MapGeneratorOptions options;
+    options.territories = 4000;
+    options.continents = 40;
+    MapGenerator generator(options);
+    generator.write(file);
+    MapLoader loader;
+    Map* board = loader.loadMap(file);
+    std::remove(file.c_str());
+    if (!board) {
+        std::cout << "Could not load the benchmark map" << std::endl;
+        return;
+    }
+    std::vector<OrderSpec> specs = buildTurn(*board);
+
+    std::cout << std::left << std::setw(24) << "" << std::right;
+    for (const char* phase : {"issue", "copy", "execute", "teardown"}) {
+        std::cout << std::setw(32) << phase;
+    }
+    std::cout << "\n" << std::left << std::setw(24) << "representation" << std::right;
+    for (int i = 0; i < 4; i++) {
+        std::cout << std::setw(12) << "allocs" << std::setw(10) << "KB" << std::setw(10) << "ms";
+    }
+    std::cout << std::endl;
+
+    TurnRun withEffects = runClassTurn(*board, specs, true);
+    TurnRun withoutEffects = runClassTurn(*board, specs, false);
+    TurnRun prechecked = runClassTurn(*board, specs, false, true);
+    TurnRun compact = runCompactTurn(*board, specs);
+    printRun("classes, text rendered", withEffects);
+    printRun("classes", withoutEffects);
+    printRun("classes, prechecked", prechecked);
+    printRun("compact", compact);
+
+    bool same = withEffects.armies == compact.armies && withEffects.neutral == compact.neutral &&
+                withEffects.executed == compact.executed && withoutEffects.armies == compact.armies &&
+                prechecked.armies == compact.armies && prechecked.neutral == compact.neutral &&
+                prechecked.executed == compact.executed;
+    std::cout << compact.executed << " of " << kOrders << " orders executed, " << compact.neutral
+              << " territories blockaded; boards " << (same ? "match" : "DIFFER") << std::endl;
+    std::cout << std::fixed << std::setprecision(3) << "Precheck on " << ThreadPool::shared().size() + 1
+              << " threads took " << prechecked.precheck.ms << " ms; " << prechecked.reused << " of " << kOrders
+              << " verdicts were still good at execution, " << kOrders - prechecked.reused
+              << " orders were validated again" << std::endl;
+    delete board;
+}
+
+namespace {
+    // Per-turn dispatch work the engine used to do: find the deploys with
+    // dynamic_cast<Deploy*>, and cross-cast every notifying order from Subject to
+    // ILoggable the way Subject::notifyObservers() did
+    size_t dispatchByCast(std::vector<Order*>& orders) {
+        auto regular = std::stable_partition(orders.begin(), orders.end(), [](Order* o) {
+            return dynamic_cast<Deploy*>(o) != nullptr;
+        });
+        size_t loggable = 0;
+        for (Order* o : orders) {
+            const Subject* subject = o;
+            if (dynamic_cast<const ILoggable*>(subject)) loggable++;
+        }
+        return (size_t)(regular - orders.begin()) + loggable;
+    }
+
+    // The same work with the priority tag; notifyObservers(*this) needs no cast
+    size_t dispatchByTag(std::vector<Order*>& orders) {
+        auto regular = std::stable_partition(orders.begin(), orders.end(), [](const Order* o) {
+            return o->getPriority() == OrderPriority::Deploy;
+        });
+        size_t loggable = 0;
+        for (Order* o : orders) {
+            const ILoggable* l = o;
+            if (l) loggable++;
+        }
+        return (size_t)(regular - orders.begin()) + loggable;
+    }
+
+    template <typename Dispatch>
+    double timeDispatch(const std::vector<std::vector<Order*>>& turn, int repeats, Dispatch dispatch, size_t& check) {
+        std::vector<std::vector<Order*>> lists = turn;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; r++) {
+            for (size_t p = 0; p < lists.size(); p++) {
+                lists[p] = turn[p];     // issue order, so every repeat partitions the same input
+                check += dispatch(lists[p]);
+            }
+        }
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repeats;
+    }
+}
+
+// Times how long one 10k-order turn spends deciding which bucket each order goes in and
+// getting each order's ILoggable for its notification, with dynamic_cast and with tags
+void testOrderDispatchBenchmark() {
+    std::cout << "\n=== Order Dispatch Benchmark (" << kOrders << " orders, " << kPlayers << " players) ===" << std::endl;
+    MapGeneratorOptions options;
+    options.territories = 4000;
+    options.continents = 40;
+    MapGenerator generator(options);
+    std::string file = "orders_benchmark.map";
+    generator.write(file);
+    MapLoader loader;
+    Map* board = loader.loadMap(file);
+    std::remove(file.c_str());
+    if (!board) {
+        std::cout << "Could not load the benchmark map" << std::endl;
+        return;
+    }
+    std::vector<Player*> players = seatPlayers(*board);
+    std::vector<std::vector<Order*>> turn(kPlayers);
+    for (const OrderSpec& spec : buildTurn(*board)) {
+        turn[spec.issuer].push_back(makeCompact(spec, *board, players).toOrder());
+    }
+
+    const int repeats = 200;
+    size_t castCheck = 0;
+    size_t tagCheck = 0;
+    double castMicros = timeDispatch(turn, repeats, dispatchByCast, castCheck);
+    double tagMicros = timeDispatch(turn, repeats, dispatchByTag, tagCheck);
+    std::cout << std::fixed << std::setprecision(1)
+              << "dynamic_cast: " << std::setw(8) << castMicros << " us/turn  "
+              << std::setw(6) << castMicros * 1000.0 / kOrders << " ns/order\n"
+              << "type tag:     " << std::setw(8) << tagMicros << " us/turn  "
+              << std::setw(6) << tagMicros * 1000.0 / kOrders << " ns/order\n"
+              << "buckets " << (castCheck == tagCheck ? "match" : "DIFFER") << std::endl;
+
+    for (std::vector<Order*>& list : turn) {
+        for (Order* o : list) delete o;
+    }
+    for (Player* p : players) delete p;
+    delete board;
+}
+
+#ifndef MAIN_DRIVER_INCLUDED
+int main() {
+    testCompactOrdersBenchmark();
+    testOrderDispatchBenchmark();
+    return 0;
+}
+#endif
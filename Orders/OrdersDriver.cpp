@@ -2,10 +2,13 @@
 #include <iostream>
 #include <algorithm>
 #include <cstddef>
+#include <string>
+#include <vector>
 
 #include "../Player/Player.h"
 #include "../Map/Map.h"
 #include "../Cards/Cards.h"
+#include "../Game_Engine/GameContext.h"
 
 /* Part 1 driver kept for reference
 // Test function demonstrating Orders and OrdersList functionality
@@ -79,7 +82,7 @@ void testOrdersLists() {
 void testOrderExecution() {
     std::cout << "=== Order Execution Demo ===" << std::endl;   // Demo header
 
-    resetOrderTurnState();      // Reset turn-specific state
+    GameContext context;        // Negotiations, card grants and the neutral player for this demo
 
     // Create players
     Player enel("Enel");
@@ -127,27 +130,27 @@ void testOrderExecution() {
     // Test various orders
     std::cout << "\n-- Deploy order validation and execution --" << std::endl;
     Deploy deploySkypiea(3, skypiea, &enel);   // Valid deploy
-    std::cout << "Valid? " << (deploySkypiea.validate() ? "yes" : "no") << std::endl;
-    deploySkypiea.execute();
+    std::cout << "Valid? " << (deploySkypiea.validate(context) ? "yes" : "no") << std::endl;
+    deploySkypiea.execute(context);
     std::cout << deploySkypiea << std::endl;
     showTerritory(skypiea);       // Show updated territory
 
     std::cout << "\n-- Deploy to enemy territory (expected invalid) --" << std::endl;
     Deploy badDeploy(2, water7, &enel);     // Invalid deploy
-    std::cout << "Valid? " << (badDeploy.validate() ? "yes" : "no") << std::endl;
-    badDeploy.execute();
+    std::cout << "Valid? " << (badDeploy.validate(context) ? "yes" : "no") << std::endl;
+    badDeploy.execute(context);
     std::cout << badDeploy << std::endl;
 
     std::cout << "\n-- Advance within owned territories --" << std::endl;
     Advance friendlyAdvance(2, skypiea, loguetown, &enel);
-    friendlyAdvance.execute();      // Valid advance
+    friendlyAdvance.execute(context);      // Valid advance
     std::cout << friendlyAdvance << std::endl;
     showTerritory(skypiea);       // Show updated territories
     showTerritory(loguetown);
 
     std::cout << "\n-- Advance attack and conquest --" << std::endl;
     Advance attackWater7(8, skypiea, water7, &enel);
-    attackWater7.execute();      // Valid attack
+    attackWater7.execute(context);      // Valid attack
     std::cout << attackWater7 << std::endl;
     showTerritory(skypiea);
     showTerritory(water7);
@@ -155,7 +158,7 @@ void testOrderExecution() {
 
     std::cout << "\n-- Second conquest in same turn --" << std::endl;
     Advance attackAlabasta(5, loguetown, alabasta, &enel);        // Second conquest
-    attackAlabasta.execute();
+    attackAlabasta.execute(context);
     std::cout << attackAlabasta << std::endl;
     showTerritory(loguetown);
     showTerritory(alabasta);
@@ -164,12 +167,12 @@ void testOrderExecution() {
 
 
     std::cout << "\n-- New turn conquest grants another card --" << std::endl;
-    resetOrderTurnState();  // New turn
+    context.resetTurn();  // New turn
     loguetown->setArmies(8); 
     sabaody->setOwner(&zoro);
     sabaody->setArmies(4);
     Advance attackSabaody(8, loguetown, sabaody, &enel);
-    attackSabaody.execute();
+    attackSabaody.execute(context);
     std::cout << attackSabaody << std::endl;
     showTerritory(loguetown);
     showTerritory(sabaody);
@@ -179,42 +182,95 @@ void testOrderExecution() {
     std::cout << "\n-- Bomb order halves armies on enemy territory --" << std::endl;
     dressrosa->setArmies(6);
     Bomb bombDressrosa(dressrosa, &enel);
-    std::cout << "Valid? " << (bombDressrosa.validate() ? "yes" : "no") << std::endl;
-    bombDressrosa.execute();
+    std::cout << "Valid? " << (bombDressrosa.validate(context) ? "yes" : "no") << std::endl;
+    bombDressrosa.execute(context);
     std::cout << bombDressrosa << std::endl;
     showTerritory(dressrosa);
 
     // Airlift order test
     std::cout << "\n-- Airlift moves armies between owned territories --" << std::endl;
     Airlift airliftOrder(2, alabasta, skypiea, &enel);
-    std::cout << "Valid? " << (airliftOrder.validate() ? "yes" : "no") << std::endl;
-    airliftOrder.execute();
+    std::cout << "Valid? " << (airliftOrder.validate(context) ? "yes" : "no") << std::endl;
+    airliftOrder.execute(context);
     std::cout << airliftOrder << std::endl;
     showTerritory(alabasta);
     showTerritory(skypiea);
 
     // Negotiate order test
     std::cout << "\n-- Negotiate prevents mutual attacks --" << std::endl;
-    resetOrderTurnState();
+    context.resetTurn();
     loguetown->setArmies(5);
     dressrosa->setArmies(3);
     Negotiate peaceWithLuffy(&luffy, &enel);   // Negotiate between Enel and Luffy
-    peaceWithLuffy.execute();
+    peaceWithLuffy.execute(context);
     std::cout << peaceWithLuffy << std::endl;
     Advance luffyAttack(3, dressrosa, loguetown, &luffy);        // Luffy tries to attack Enel
-    luffyAttack.execute();
+    luffyAttack.execute(context);
     std::cout << luffyAttack << std::endl;
     Advance enelAttack(3, loguetown, dressrosa, &enel);    // Enel tries to attack Luffy
-    enelAttack.execute();
+    enelAttack.execute(context);
     std::cout << enelAttack << std::endl;
+    std::cout << "  " << context << std::endl;
 
     // Blockade order test
     std::cout << "\n-- Blockade doubles armies and transfers to Neutral --" << std::endl;
     Blockade blockadeLoguetown(loguetown, &enel);
-    blockadeLoguetown.execute();
+    blockadeLoguetown.execute(context);
     std::cout << blockadeLoguetown << std::endl;
     showTerritory(loguetown);
 
+    // Precheck test: the blockade changes Skypiea's owner, so only the deploy is validated again
+    std::cout << "\n-- Prechecked verdicts are reused until an order changes their territories --" << std::endl;
+    Deploy laterDeploy(2, skypiea, &enel);
+    Blockade blockadeSkypiea(skypiea, &enel);
+    laterDeploy.precheck(context);
+    blockadeSkypiea.precheck(context);
+    bool reused = blockadeSkypiea.executeChecked(context);
+    std::cout << blockadeSkypiea << (reused ? " (verdict reused)" : " (validated again)") << std::endl;
+    reused = laterDeploy.executeChecked(context);
+    std::cout << laterDeploy << (reused ? " (verdict reused)" : " (validated again)") << std::endl;
+    showTerritory(skypiea);
+
+    // Execution queue test
+    std::cout << "\n-- Orders list hands out deploys first, then the rest in order --" << std::endl;
+    OrdersList queue;
+    queue.add(new Advance(1, skypiea, loguetown, &enel));
+    queue.add(new Deploy(2, skypiea, &enel));
+    queue.add(new Bomb(dressrosa, &enel));
+    queue.add(new Deploy(1, skypiea, &enel));
+    queue.beginExecution();
+    std::cout << "  Taken:";
+    while (Order* o = queue.nextDeploy()) {
+        std::cout << " " << o->getType();
+    }
+    while (Order* o = queue.next()) {
+        std::cout << " " << o->getType();
+    }
+    std::cout << std::endl;
+    int taken = queue.endExecution();
+    std::cout << "  " << taken << " taken, " << queue.getOrders()->size() << " left" << std::endl;
+
+    // Large game test: the context grows with the players it sees
+    std::cout << "\n-- Negotiations and card grants hold for any number of players --" << std::endl;
+    GameContext crowded;
+    std::vector<Player*> crowd;
+    for (int i = 0; i < 70; i++) {
+        crowd.push_back(new Player("P" + std::to_string(i + 1)));
+        crowded.addPlayer(crowd.back());
+        if (i == 2) crowded.addNegotiation(crowd[1], crowd[2]);     // made before the matrix grows
+    }
+    Negotiate lastPeace(crowd[69], crowd[0]);
+    lastPeace.execute(crowded);
+    crowded.markCardGranted(crowd[69]);
+    std::cout << "  P1/P70 negotiated: " << (crowded.hasNegotiation(crowd[69], crowd[0]) ? "yes" : "no")
+              << ", P70 granted a card: " << (crowded.wasCardGranted(crowd[69]) ? "yes" : "no")
+              << ", P2/P3 still negotiated: " << (crowded.hasNegotiation(crowd[2], crowd[1]) ? "yes" : "no")
+              << ", P2/P70 negotiated: " << (crowded.hasNegotiation(crowd[1], crowd[69]) ? "yes" : "no") << std::endl;
+    std::cout << "  " << crowded << std::endl;
+    for (Player* p : crowd) {
+        delete p;
+    }
+
     /* Part 1 simple cleanup would delete territories here
     delete skypiea;
     delete loguetown;
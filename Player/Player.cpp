@@ -1,5 +1,6 @@
 #include "Player.h"
 #include "PlayerStrategies.h"
+#include "../Game_Engine/GameOutput.h"
 
 using namespace std;
 
@@ -10,6 +11,7 @@ Player::Player(const std::string& name) : name(name) {
     territories = new std::vector<Territory*>();
     reinforcementPool = new int(0);
     strategy = nullptr; // Added in A3: Initialize strategy to null
+    output = &GameOutput::console();
 }
 
 // Added in A3: Constructor with strategy
@@ -18,6 +20,7 @@ Player::Player(const std::string& name, PlayerStrategy* strat) : name(name) {
     hand = new WarzoneCard::Hand();
     territories = new std::vector<Territory*>();
     reinforcementPool = new int(0);
+    output = &GameOutput::console();
     strategy = strat; // Added in A3: Set the strategy
     if (strategy) {
         strategy->setPlayer(this); // Link strategy back to this player
@@ -26,7 +29,7 @@ Player::Player(const std::string& name, PlayerStrategy* strat) : name(name) {
 
 // Copy constructor
 Player::Player(const Player& other) 
-    : name(other.name) {
+    : name(other.name), output(other.output) {
     ordersList = new OrdersList(*other.ordersList);
     hand = other.hand ? new WarzoneCard::Hand(*other.hand) : new WarzoneCard::Hand();
     territories = new std::vector<Territory*>(*other.territories);
@@ -55,6 +58,7 @@ Player& Player::operator=(const Player& other) {
         hand = other.hand ? new WarzoneCard::Hand(*other.hand) : new WarzoneCard::Hand();
         territories = new std::vector<Territory*>(*other.territories);
         reinforcementPool = new int(*other.reinforcementPool);
+        output = other.output;
         
         // Added in A3: Deep copy the strategy
         if (other.strategy) {
@@ -76,7 +80,7 @@ Player::~Player() {
     delete strategy; // Added in A3: Clean up strategy
 }
 
-std::string Player::getName() const {
+const std::string& Player::getName() const {
     return name;
 }
 
@@ -128,6 +132,14 @@ void Player::setStrategy(PlayerStrategy* strat) {
     }
 }
 
+GameOutput* Player::getOutput() const {
+    return output;
+}
+
+void Player::setOutput(GameOutput* out) {
+    output = out ? out : &GameOutput::console();
+}
+
 // MODIFIED in A3: Now delegates to strategy if available, otherwise uses default behavior
 std::vector<Territory*>* Player::toDefend() {
     if (strategy != nullptr) {
@@ -173,8 +185,8 @@ void Player::issueOrder() {
         ordersList->add(deployOrder);
         *reinforcementPool -= toDeploy;
         
-        std::cout << name << " issued Deploy order: " << toDeploy 
-                  << " armies to " << target->getName() << std::endl;
+        output->print(name, " issued Deploy order: ", toDeploy, " armies to ", target->getName());
+        output->record({GameEventType::OrderIssued, this, toDeploy, "Deploy"});
         return;
     }
     
@@ -191,8 +203,9 @@ void Player::issueOrder() {
                         Advance* advanceOrder = new Advance(armiesToMove, source, target, this);
                         ordersList->add(advanceOrder);
                         
-                        std::cout << name << " issued Advance order: " << armiesToMove 
-                                  << " from " << source->getName() << " to " << target->getName() << std::endl;
+                        output->print(name, " issued Advance order: ", armiesToMove, " from ",
+                                      source->getName(), " to ", target->getName());
+                        output->record({GameEventType::OrderIssued, this, armiesToMove, "Advance"});
                         delete targets;
                         return;  
                     }
@@ -205,14 +218,14 @@ void Player::issueOrder() {
     // Priority 3: Play a card if we have one
     if (hand && !hand->getHandCards().empty()) {
         WarzoneCard::Card* card = hand->getHandCards()[0];
-        std::cout << name << " playing card: " << *card << std::endl;
+        output->print(name, " playing card: ", *card);
         card->play(this);
         hand->removeCardFromHand(card);
         return;
     }
     
     // If we reach here, player is done
-    std::cout << name << " has no more orders to issue" << std::endl;
+    output->print(name, " has no more orders to issue");
 }
 
 std::ostream& operator<<(std::ostream& os, const Player& player) {
@@ -8,6 +8,7 @@
 
 // Forward declaration
 class PlayerStrategy;
+class GameOutput;
 
 class Player {
     private:
@@ -17,6 +18,7 @@ class Player {
         OrdersList* ordersList;
         int* reinforcementPool;
         PlayerStrategy* strategy; // Added in A3: Strategy pointer for delegation
+        GameOutput* output;       // where issueOrder reports, not owned
 
     public:
         Player(const std::string& name);
@@ -25,7 +27,7 @@ class Player {
         Player& operator=(const Player& other);
         ~Player();
 
-        std::string getName() const;
+        const std::string& getName() const;     // a reference, so output that is never printed builds no copy
         std::vector<Territory*>* getTerritories() const;
         WarzoneCard::Hand* getHand() const;
         OrdersList* getOrdersList() const;
@@ -40,6 +42,10 @@ class Player {
         PlayerStrategy* getStrategy() const;
         void setStrategy(PlayerStrategy* strat);
 
+        // Defaults to the console; nullptr restores it
+        GameOutput* getOutput() const;
+        void setOutput(GameOutput* out);
+
         std::vector<Territory*>* toDefend();        
         std::vector<Territory*>* toAttack();        
         void issueOrder();  
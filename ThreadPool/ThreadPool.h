@@ -0,0 +1,49 @@
+#pragma once
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed-size pool of worker threads used by the map and engine batch paths.
+ * parallelFor lets the calling thread take part in the work, so it is safe to
+ * call from inside a task that is itself running on the pool.
+ */
+class ThreadPool {
+public:
+    // 0 threads means one per hardware thread
+    explicit ThreadPool(size_t threads = 0);
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+    ~ThreadPool();
+
+    size_t size() const;
+
+    // Queue a task for any idle worker
+    void submit(std::function<void()> task);
+
+    // Run body(i) for every i in [0, count) and return once all calls finished. If a
+    // call throws, no further items start; the first exception is rethrown here once
+    // the calls already running have finished.
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    // Process-wide pool sized to the hardware
+    static ThreadPool& shared();
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping;
+
+    void workerLoop();
+};
+
+#endif